@@ -1,12 +1,12 @@
 #version 450 core
 in vec2 TexCoords;
+in vec4 SpriteColor;
 
 out vec4 color;
 
 uniform sampler2D image;
-uniform vec3 spriteColor;
 
 void main()
 {
-	color = vec4(spriteColor, 1.0) * texture(image, TexCoords);
+	color = SpriteColor * texture(image, TexCoords);
 }
\ No newline at end of file
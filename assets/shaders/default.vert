@@ -1,13 +1,28 @@
 #version 450 core
-layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
+layout (location = 0) in vec4 vertex;         // <vec2 position, vec2 texCoords>
+layout (location = 1) in vec4 spriteRect;     // <vec2 position, vec2 size>
+layout (location = 2) in vec4 spriteColor;
+layout (location = 3) in vec4 spriteRegion;   // <vec2 offset, vec2 scale> inside the texture
+layout (location = 4) in float spriteRotation; // degrees
 
 out vec2 TexCoords;
+out vec4 SpriteColor;
 
-uniform mat4 model;
-uniform mat4 projection;
+layout (std140, binding = 0) uniform Frame
+{
+	mat4 projection;
+	float time;
+};
 
 void main()
 {
-	TexCoords = vertex.zw;
-	gl_Position = projection * model * vec4(vertex.xy, 0.0, 1.0);
+	// Scale the unit quad, then rotate it around the sprite center
+	vec2 size = spriteRect.zw;
+	vec2 local = vertex.xy * size - 0.5 * size;
+	float angle = radians(spriteRotation);
+	vec2 rotated = vec2(cos(angle) * local.x - sin(angle) * local.y, sin(angle) * local.x + cos(angle) * local.y);
+
+	TexCoords = spriteRegion.xy + vertex.zw * spriteRegion.zw;
+	SpriteColor = spriteColor;
+	gl_Position = projection * vec4(rotated + 0.5 * size + spriteRect.xy, 0.0, 1.0);
 }
\ No newline at end of file
@@ -1,17 +1,22 @@
 #version 450 core
-layout (location = 0) in vec4 vertex;
+layout (location = 0) in vec4 vertex;         // <vec2 position, vec2 texCoords>
+layout (location = 1) in vec2 particleOffset;
+layout (location = 2) in vec4 particleColor;
 
 out vec2 TexCoords;
 out vec4 ParticleColor;
 
-uniform mat4 projection;
-uniform vec2 offset;
-uniform vec4 color;
+layout (std140, binding = 0) uniform Frame
+{
+	mat4 projection;
+	float time;
+};
+uniform vec4 region; // <vec2 offset, vec2 scale> inside the texture
 
 void main()
 {
 	float scale = 10.0f;
-	TexCoords = vertex.zw;
-	ParticleColor = color;
-	gl_Position = projection * vec4((vertex.xy * scale) + offset, 0.0, 1.0);
+	TexCoords = region.xy + vertex.zw * region.zw;
+	ParticleColor = particleColor;
+	gl_Position = projection * vec4((vertex.xy * scale) + particleOffset, 0.0, 1.0);
 }
\ No newline at end of file
@@ -6,7 +6,12 @@ out vec2 TexCoords;
 uniform bool  chaos;
 uniform bool  confuse;
 uniform bool  shake;
-uniform float time;
+
+layout (std140, binding = 0) uniform Frame
+{
+    mat4 projection;
+    float time;
+};
 
 void main()
 {
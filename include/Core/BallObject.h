@@ -7,9 +7,8 @@ class BallObject :
 {
 public:
     BallObject();
-    BallObject(glm::vec2 position, float radius, glm::vec2 velocity, Texture2D sprite);
+    BallObject(glm::vec2 position, float radius, glm::vec2 velocity);
 
-    glm::vec2 Move(float deltaTime, unsigned int windowWidth);
     void Reset(glm::vec2 position, glm::vec2 velocity);
 
 public:
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Brick colors, indexed by BrickField::ColorIndices
+const glm::vec3 BRICK_COLORS[]{
+    glm::vec3{ 1.0f, 1.0f, 1.0f },  // default: white
+    glm::vec3{ 0.8f, 0.8f, 0.7f },  // solid
+    glm::vec3{ 0.2f, 0.6f, 1.0f },
+    glm::vec3{ 0.0f, 0.7f, 0.0f },
+    glm::vec3{ 0.8f, 0.8f, 0.4f },
+    glm::vec3{ 1.0f, 0.5f, 0.0f }
+};
+
+// Structure-of-arrays brick storage. Hot collision data lives in contiguous arrays and the
+// destroyed/solid flags are packed into 64-bit words; the texture is implied by the solid flag.
+class BrickField
+{
+public:
+    // Remove all bricks
+    void Clear();
+    // Preallocate storage for the given number of bricks
+    void Reserve(unsigned int count);
+    // Append a brick and return its index
+    unsigned int Add(glm::vec2 position, glm::vec2 size, bool solid, unsigned char colorIndex);
+    // Bring every destroyed brick back; the layout never changes after loading, so this restores the loaded state
+    void Restore();
+    // Mark a brick destroyed
+    void Destroy(unsigned int index);
+    // Take over which bricks are destroyed from a field with the same layout
+    void CopyDestroyed(const BrickField& other);
+    // Check if every destructible brick is destroyed
+    bool AllCleared() const { return this->remaining == 0; }
+
+    unsigned int Count() const { return static_cast<unsigned int>(this->Positions.size()); }
+    bool IsDestroyed(unsigned int index) const { return (this->destroyed[index >> 6] >> (index & 63)) & 1; }
+    bool IsSolid(unsigned int index) const { return (this->solid[index >> 6] >> (index & 63)) & 1; }
+    // Number of destructible bricks in total
+    unsigned int Destructible() const { return this->destructible; }
+    // Number of destructible bricks not destroyed yet
+    unsigned int Remaining() const { return this->remaining; }
+    // Continue a state hash with the destroyed flags; the layout is fixed by the level file
+    std::uint64_t Hash(std::uint64_t hash) const;
+
+public:
+    // Brick state
+    std::vector<glm::vec2> Positions;
+    std::vector<glm::vec2> Sizes;
+    std::vector<unsigned char> ColorIndices;
+
+private:
+    // One bit per brick
+    std::vector<std::uint64_t> destroyed;
+    std::vector<std::uint64_t> solid;
+
+    // Destructible bricks in total and still standing, kept up to date by Add, Destroy and Restore
+    unsigned int destructible{ 0 };
+    unsigned int remaining{ 0 };
+};
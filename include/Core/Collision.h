@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "GameObject.h"
+
+// Where a moving circle first touches something
+struct SweepHit
+{
+    // Fraction of the motion travelled at the moment of contact
+    float Time;
+    // Unit surface normal at the contact, pointing towards the circle
+    glm::vec2 Normal;
+};
+
+// Number of boxes prefiltered per sweep iteration: AVX2 when the compiler targets it, SSE2 on x86/x64, scalar otherwise
+#if defined(__AVX2__)
+const unsigned int COLLISION_LANES = 8;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+const unsigned int COLLISION_LANES = 4;
+#else
+const unsigned int COLLISION_LANES = 1;
+#endif
+
+// Boxes in structure-of-arrays layout for the batched sweep, padded to a multiple of COLLISION_LANES
+class BoxBatch
+{
+public:
+    // Remove all boxes
+    void Clear();
+    // Append a box
+    void Add(glm::vec2 position, glm::vec2 size);
+
+    unsigned int Count() const { return this->count; }
+
+public:
+    std::vector<float> X, Y, Width, Height;
+
+private:
+    unsigned int count{ 0 };
+};
+
+// AABB - AABB collision
+bool CheckCollision(GameObject& one, GameObject& two);
+// Swept circle - AABB collision: whether a circle moving from 'center' by 'motion' touches the box within the motion.
+// The box is widened by the radius with rounded corners and a ray is cast against that. A circle that already overlaps
+// the box hits at time 0, unless it is moving away from it.
+bool SweepCircle(glm::vec2 center, float radius, glm::vec2 motion, glm::vec2 position, glm::vec2 size, SweepHit& hit);
+// Earliest hit of a swept circle among the boxes in [first, last); returns its index, or 'last' if there is none. Equal
+// times go to the lower index. Blocks of COLLISION_LANES boxes are prefiltered with vector instructions, so results
+// are identical to sweeping each box in order.
+unsigned int SweepCircle(glm::vec2 center, float radius, glm::vec2 motion, const BoxBatch& boxes, unsigned int first, unsigned int last, SweepHit& hit);
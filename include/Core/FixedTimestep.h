@@ -0,0 +1,27 @@
+#pragma once
+
+// Most ticks run for one frame before the remaining backlog is dropped
+const unsigned int MAX_CATCH_UP_TICKS{ 8 };
+
+// Turns variable frame times into a whole number of fixed simulation ticks. Real time is kept in double seconds and
+// the tick count in 64 bits, so neither loses precision over long sessions.
+class FixedTimestep
+{
+public:
+    FixedTimestep(double tickLength, unsigned int maxCatchUpTicks = MAX_CATCH_UP_TICKS);
+
+    // Add the real time since the last frame and return how many ticks to simulate for it. After a hitch at most
+    // maxCatchUpTicks run and the rest of the backlog is dropped, so the simulation slows down instead of spiraling.
+    unsigned int Advance(double elapsed);
+
+    // How far real time has moved into the next tick, in [0, 1); blends the last two simulated states when rendering
+    float Alpha() const { return static_cast<float>(this->accumulator / this->tickLength); }
+    double TickLength() const { return this->tickLength; }
+    unsigned long long Ticks() const { return this->ticks; }
+
+private:
+    double tickLength;
+    unsigned int maxCatchUpTicks;
+    double accumulator{ 0.0 };
+    unsigned long long ticks{ 0 };
+};
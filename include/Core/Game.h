@@ -1,42 +1,22 @@
 #pragma once
 
-#include <vector>
-#include <tuple>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
-#include "GameLevel.h"
-#include "PowerUp.h"
-
-enum GameState
-{
-    GAME_ACTIVE,
-    GAME_MENU,
-    GAME_WIN
-};
-
-enum Direction
-{
-    UP,
-    RIGHT,
-    DOWN,
-    LEFT
-};
-
-typedef std::tuple<bool, Direction, glm::vec2> Collision;
-
-// Initial size of the player paddle
-const glm::vec2 PLAYER_SIZE{ 100.0f, 20.0f };
-// Initial velocity of the player paddle
-const float PLAYER_VELOCITY{ 500.0f };
-
-// Initial velocity of the ball
-const glm::vec2 INITIAL_BALL_VELOCITY{ 100.0f, -350.0f };
-// Radius of the ball
-const float BALL_RADIUS = 12.5f;
+#include "FixedTimestep.h"
+#include "GameSim.h"
+#include "InputRecording.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
 
+// Windowed presentation layer on top of the headless GameSim. Between Start and Stop the sim runs on its own thread at
+// a fixed tick rate and publishes a RenderSnapshot after each batch of ticks; Render draws the newest one on the GL
+// thread, so a frame blocked on vsync never holds the simulation back.
 class Game
 {
 public:    
@@ -47,23 +27,34 @@ public:
     // Initialize game state
     void Init();
 
-    // Game loop
-    void ProcessInput(float deltaTime);
-    void Update(float deltaTime);
+    // Start and stop the simulation thread; the sim must not be touched from elsewhere in between
+    void Start();
+    void Stop();
+
+    // Draw the newest snapshot, moving objects blended between their last two ticks
     void Render();
-    void DoCollisions();
-    void ResetLevel();
-    void ResetPlayer();
-    void SpawnPowerUps(GameObject& block);
-    void UpdatePowerUps(float deltaTime);
 
 public:
     // Game state
-    GameState State;
-    bool Keys[1024];
+    // Written by the window thread, read by the simulation thread
+    std::atomic<bool> Keys[1024];
     unsigned int Width, Height;
-    std::vector<GameLevel> Levels;
-    unsigned int Level{ 0 };
-    std::vector<PowerUp> PowerUps;
+    GameSim Sim;
+    FixedTimestep Clock;
+    // Records the input of every tick while open; open it before Start and close it after Stop
+    InputRecorder Recorder;
+
+private:
+    // Simulation thread body
+    void simulate();
+    // Seconds since Start, shared by both threads
+    double now() const;
+
+private:
+    std::thread simThread;
+    std::atomic<bool> running{ false };
+    std::chrono::steady_clock::time_point startTime;
+    TripleBuffer<RenderSnapshot> snapshots;
+    // Last tick the particles were advanced to
+    unsigned long long particleTick{ 0 };
 };
-
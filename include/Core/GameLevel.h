@@ -1,10 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
-#include <Rendering/SpriteRenderer.h>
-#include "GameObject.h"
+#include <glm/glm.hpp>
 
+#include "BrickField.h"
+
+// Header of a compiled level file
+struct LevelFileHeader
+{
+    char Magic[4];          // "BLVL"
+    std::uint32_t Version;  // LEVEL_FILE_VERSION
+    std::uint32_t Width;    // Tiles per row
+    std::uint32_t Height;   // Rows
+};
+
+const std::uint32_t LEVEL_FILE_VERSION = 1;
 
 class GameLevel
 {
@@ -12,20 +24,39 @@ public:
     // Constructor
     GameLevel() {}
 
-    // Load level from file
-    void Load(const char* file, unsigned int levelWidth, unsigned int levelHeight);
-    // Render level
-    void Draw(SpriteRenderer& renderer);
-    // Check if the level is completed
-    bool IsCompleted();
+    // Load level from file. Compiled ".blevel" files are memory-mapped; if one cannot be read the ".level" text file
+    // next to it is parsed instead. Any other file is parsed as text. Returns false, leaving the level empty, if no
+    // file could be read.
+    bool Load(const char* file, unsigned int levelWidth, unsigned int levelHeight);
+    // Compile a text level into the binary format: a LevelFileHeader followed by width * height tile codes, one byte
+    // each, row by row
+    static bool Compile(const char* source, const char* target);
+    // Restore the level to its state right after loading, without touching the file
+    void Reset();
+    // Check if the level has any bricks to clear; empty or unloaded levels do not
+    bool IsPlayable() const { return this->Bricks.Destructible() > 0; }
+    // Check if the level is completed; a level that is not playable never is
+    bool IsCompleted() const;
+    // Collect the indices of all intact bricks whose grid cells overlap the given region, in row-major order
+    void QueryBricks(glm::vec2 min, glm::vec2 max, std::vector<unsigned int>& result) const;
 
 public:
     // Level state
-    std::vector<GameObject> Bricks;
+    BrickField Bricks;
+
+private:
+    // Broadphase grid: brick index per tile, -1 for empty tiles
+    std::vector<int> grid;
+    unsigned int gridWidth{ 0 }, gridHeight{ 0 };
+    float unitWidth{ 0.0f }, unitHeight{ 0.0f };
 
 private:
-    // Initialize level from tile data
-    void init(std::vector<std::vector<unsigned int>> tileData,
+    // Load a compiled level
+    bool loadBinary(const char* file, unsigned int levelWidth, unsigned int levelHeight);
+    // Parse a text level into row-major tile codes
+    static bool parseText(const char* file, std::vector<unsigned char>& tiles, unsigned int& width, unsigned int& height);
+    // Initialize level from row-major tile codes
+    void init(const unsigned char* tiles, unsigned int width, unsigned int height,
         unsigned int levelWidth, unsigned int levelHeight);
 };
 
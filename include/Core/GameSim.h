@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Collision.h"
+#include "GameLevel.h"
+#include "LevelStreamer.h"
+#include "GameObject.h"
+#include "BallObject.h"
+#include "Hash.h"
+#include "PowerUp.h"
+
+enum GameState
+{
+    GAME_ACTIVE,
+    GAME_MENU,
+    GAME_WIN
+};
+
+// Initial size of the player paddle
+const glm::vec2 PLAYER_SIZE{ 100.0f, 20.0f };
+// Initial velocity of the player paddle
+const float PLAYER_VELOCITY{ 500.0f };
+
+// Initial velocity of the ball
+const glm::vec2 INITIAL_BALL_VELOCITY{ 100.0f, -350.0f };
+// Radius of the ball
+const float BALL_RADIUS = 12.5f;
+// Most balls in play at once; splitting stops here
+const unsigned int MAX_BALLS{ 8192 };
+
+// Length of one fixed simulation tick in seconds
+const float SIM_TICK{ 1.0f / 120.0f };
+
+// Player input sampled for one simulation step
+struct SimInput
+{
+    bool Left{ false };
+    bool Right{ false };
+    bool Launch{ false };
+};
+
+// Pending expiry of a timed power-up effect
+struct PowerUpTimer
+{
+    double Expires;
+    PowerUpType Type;
+
+    bool operator>(const PowerUpTimer& other) const { return this->Expires > other.Expires; }
+};
+
+// Headless game simulation: levels, paddle, ball and power-ups without any window, GL or texture state
+class GameSim
+{
+public:
+    // Constructor
+    GameSim(unsigned int width, unsigned int height);
+
+    // Load levels and place the player and ball. All randomness in the sim comes from 'seed', so the same seed and
+    // the same inputs tick for tick always play out the same.
+    void Init(std::uint32_t seed);
+
+    // Simulation step
+    void Step(const SimInput& input, float deltaTime);
+    void ProcessInput(const SimInput& input, float deltaTime);
+    void Update(float deltaTime);
+    // Move every ball, bouncing off bricks, walls and the paddle along the way, then collide the paddle with the power-ups
+    void DoCollisions(float deltaTime);
+    void ResetLevel();
+    // Switch to the next level, from a fresh start
+    void NextLevel();
+    // Put the paddle back and leave a single ball stuck to it
+    void ResetPlayer();
+    // Turn every ball into three, fanned out around its direction, up to MAX_BALLS
+    void SplitBalls();
+    void SpawnPowerUps(glm::vec2 position);
+    void ActivatePowerUp(PowerUpType type);
+    void UpdatePowerUps(float deltaTime);
+    // Drop all power-ups and end their effects
+    void ClearPowerUps();
+    // Continue a hash of everything that decides how the game plays on; replays compare these to find where two runs
+    // part ways
+    std::uint64_t Hash(std::uint64_t hash = HASH_SEED) const;
+
+public:
+    // Game state
+    GameState State;
+    unsigned int Width, Height;
+    // Simulated seconds since Init
+    double Time{ 0.0 };
+    // Seed given to Init
+    std::uint32_t Seed{ 0 };
+    LevelStreamer Levels;
+    std::vector<PowerUp> PowerUps;
+    GameObject Player;
+    // Balls in play; never empty while the game runs
+    std::vector<BallObject> Balls;
+
+    // Effect state, mirrored into the post-processor by the presentation layer
+    bool Confuse{ false };
+    bool Chaos{ false };
+    bool Shake{ false };
+    float ShakeTime{ 0.0f };
+
+private:
+    // Collision state of one job's range of balls. Jobs only read the bricks and record what they hit; the records are
+    // applied afterwards in ball order, so the outcome does not depend on scheduling.
+    struct CollisionChunk
+    {
+        // Broadphase query results, and the ones that can stop the ball with their boxes for the narrowphase, reused
+        // between steps
+        std::vector<unsigned int> NearbyBricks;
+        std::vector<unsigned int> BlockingBricks;
+        BoxBatch Candidates;
+        // Breakable bricks hit, in ball order and then hit order
+        std::vector<unsigned int> HitBricks;
+        bool HitSolid{ false };
+    };
+    std::vector<CollisionChunk> collisionChunks;
+
+    // Sweep one ball through a step, bouncing off everything it touches in order of contact and recording brick hits in
+    // the chunk. Checking the whole path rather than the end position keeps fast balls from tunnelling through bricks.
+    void collideBall(BallObject& ball, CollisionChunk& chunk, float deltaTime);
+    // Roll a 1 in 'chance'
+    bool shouldSpawn(unsigned int chance);
+
+    // Active power-ups per kind, and the expiry of each one, soonest first
+    unsigned int activeEffects[POWERUP_TYPE_COUNT]{};
+    std::priority_queue<PowerUpTimer, std::vector<PowerUpTimer>, std::greater<PowerUpTimer>> effectTimers;
+
+    // Power-up spawn rolls; only drawn from during the ordered part of a step
+    std::mt19937 random;
+};
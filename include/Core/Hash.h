@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Initial value of a 64-bit FNV-1a hash
+const std::uint64_t HASH_SEED = 14695981039346656037ull;
+
+// 64-bit FNV-1a hash of a byte range; pass an earlier result as 'hash' to continue hashing more data
+inline std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t hash = HASH_SEED)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GameSim.h"
+#include "MappedFile.h"
+
+// Header of a recorded input stream
+struct RecordingFileHeader
+{
+    char Magic[4];          // "BREC"
+    std::uint32_t Version;  // RECORDING_FILE_VERSION
+    std::uint32_t Seed;     // Seed the sim was initialized with
+    std::uint32_t Width;    // Sim size
+    std::uint32_t Height;
+    float TickLength;       // Seconds per tick
+};
+
+const std::uint32_t RECORDING_FILE_VERSION = 1;
+// Input byte of the event that ends a recording
+const unsigned char END_OF_INPUT = 0xFF;
+
+// Writes the input of every sim tick to a file. The header is followed by one event per input change: the number of
+// ticks since the previous event as a base-128 varint, then a byte of input bits. A final event with the END_OF_INPUT
+// byte holds the ticks after the last change. Encoding runs on the calling thread, which only hands full blocks over
+// to a writer thread, so recording costs the sim thread next to nothing.
+class InputRecorder
+{
+public:
+    InputRecorder() {}
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // Create the file and start the writer thread; returns false if the file cannot be created
+    bool Open(const char* file, const GameSim& sim, float tickLength);
+    // Write the end marker, wait for everything to be written and close the file
+    void Close();
+    bool IsOpen() const { return this->writer.joinable(); }
+
+    // Record the input of the next tick; does nothing unless open
+    void Record(const SimInput& input);
+
+private:
+    // Encode an event at the current tick
+    void writeEvent(unsigned char bits);
+    // Hand the encoded events over to the writer thread
+    void flush();
+    // Writer thread body
+    void writeLoop();
+
+private:
+    std::ofstream stream;
+    std::thread writer;
+
+    // Encoded events not handed over yet; only touched by the recording thread
+    std::vector<unsigned char> buffer;
+    unsigned char lastInput{ 0 };
+    unsigned long long tick{ 0 };
+    unsigned long long lastEventTick{ 0 };
+
+    // Blocks waiting for the writer thread
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<std::vector<unsigned char>> pending;
+    bool closing{ false };
+};
+
+// Reads a recorded input stream back tick by tick
+class InputReplay
+{
+public:
+    // Map the file and check its header; returns false if it is not a recording
+    bool Open(const char* file);
+
+    const RecordingFileHeader& Header() const { return this->header; }
+
+    // Input of the next tick; returns false once the recording is over
+    bool Next(SimInput& input);
+
+private:
+    // Decode the next event, returning false at the end of the stream
+    bool readEvent();
+
+private:
+    MappedFile file;
+    RecordingFileHeader header{};
+    std::size_t offset{ 0 };
+
+    // Input in effect and the ticks left until the next event
+    unsigned char input{ 0 };
+    unsigned long long ticksLeft{ 0 };
+    unsigned char nextInput{ END_OF_INPUT };
+};
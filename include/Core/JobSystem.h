@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job;
+
+// Deques for threads that are not workers, such as the simulation and render threads. Each such thread gets its own on
+// first use, so they do not contend on one lock; beyond this many they share.
+const unsigned int EXTERNAL_QUEUES{ 4 };
+
+// Number of jobs of a group that have not finished yet. Jobs can be made to wait for a counter to reach zero, which
+// is how dependencies between groups are expressed.
+class JobCounter
+{
+public:
+    bool Done() const { return this->value.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<unsigned int> value{ 0 };
+    // Jobs held back until the counter reaches zero
+    std::mutex lock;
+    std::vector<Job*> dependents;
+};
+
+// Work-stealing job scheduler. Every worker owns a deque: it pushes and pops its own jobs at the back, and idle workers
+// steal the oldest jobs from the front of the others. Threads that are not workers queue into deques of their own as
+// well (see EXTERNAL_QUEUES). Waiting on a counter runs queued jobs while there are any, so jobs may wait on other
+// jobs, and only sleeps once there is nothing left to take. Without any workers started, jobs still run, just all on
+// the waiting thread.
+class JobSystem
+{
+public:
+    // Start the worker threads; by default one less than there are hardware threads, leaving one for the caller
+    static void Start(unsigned int workers = 0);
+    // Finish the queued jobs and stop the workers
+    static void Stop();
+
+    static unsigned int WorkerCount() { return static_cast<unsigned int>(threads.size()); }
+
+    // Queue a job. 'counter' counts it until it finishes; if 'dependency' is given, the job only starts once that
+    // counter reaches zero.
+    static void Run(std::function<void()> work, JobCounter& counter, JobCounter* dependency = nullptr);
+    // Run queued jobs on this thread until the counter reaches zero, sleeping while there are none
+    static void Wait(JobCounter& counter);
+
+    // Call body(first, last) for consecutive ranges covering [0, count), at most 'grain' items each, and return once
+    // all are done. Ranges start at multiples of 'grain', so bodies can keep state per range at first / grain. Small
+    // counts, or no workers, run inline on the caller, range by range.
+    template <typename Body>
+    static void ParallelFor(unsigned int count, unsigned int grain, const Body& body)
+    {
+        if (count <= grain || threads.empty())
+        {
+            for (unsigned int first = 0; first < count; first += grain)
+                body(first, std::min(first + grain, count));
+            return;
+        }
+
+        JobCounter counter;
+        for (unsigned int first = grain; first < count; first += grain)
+        {
+            unsigned int last = std::min(first + grain, count);
+            Run([&body, first, last]() { body(first, last); }, counter);
+        }
+
+        // The first range runs here while the workers pick up the rest
+        body(0u, grain);
+        Wait(counter);
+    }
+
+private:
+    JobSystem() {}
+
+    // Deque of one worker, or of threads that are not workers at the end
+    struct Queue
+    {
+        std::mutex Lock;
+        std::deque<Job*> Jobs;
+    };
+
+    // Before Start there are no workers, only the external deques
+    static std::vector<std::unique_ptr<Queue>> externalQueuesOnly();
+    static void workerLoop(unsigned int index);
+    // Index of the calling thread's deque
+    static unsigned int self();
+    static void push(Job* job);
+    // Take a job from this thread's own deque, or steal one; nullptr if there is none
+    static Job* take();
+    static void execute(Job* job);
+    static void finish(JobCounter& counter);
+
+    static std::vector<std::thread> threads;
+    static std::vector<std::unique_ptr<Queue>> queues;
+    static std::atomic<bool> stopping;
+    // Queued jobs not taken yet; idle workers and waiting threads sleep while it is zero
+    static std::atomic<unsigned int> queued;
+    // External deques handed out so far
+    static std::atomic<unsigned int> externalThreads;
+    static std::mutex sleepLock;
+    static std::condition_variable wake;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "GameLevel.h"
+
+// Keeps only the active level and the one after it in memory. The next level is loaded on a background thread while
+// the active one is played and moved in when the game advances. Levels that fail to load or have no bricks to clear
+// are reported and skipped.
+class LevelStreamer
+{
+public:
+    LevelStreamer(unsigned int levelWidth, unsigned int levelHeight);
+    ~LevelStreamer();
+
+    // Load the given level synchronously and start prefetching the one after it
+    void Start(std::vector<std::string> files, unsigned int first);
+    // Make the next level active, waiting for its prefetch if it has not finished, and start prefetching the one after
+    void Advance();
+
+    GameLevel& Current() { return this->current; }
+    const GameLevel& Current() const { return this->current; }
+    unsigned int CurrentIndex() const { return this->currentIndex; }
+    unsigned int Count() const { return static_cast<unsigned int>(this->files.size()); }
+    // Changes whenever another level becomes current; the brick layout never changes in between
+    unsigned int Version() const { return this->version; }
+
+private:
+    // Start loading the level after the current one, wrapping after the last
+    void prefetch();
+    // Make the prefetched level active
+    void advance();
+    // Advance past levels that are not playable, at most once around the list
+    void skipUnplayable();
+
+private:
+    std::vector<std::string> files;
+    unsigned int levelWidth, levelHeight;
+
+    GameLevel current;
+    unsigned int currentIndex{ 0 };
+    unsigned int version{ 0 };
+    std::future<GameLevel> next;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the file, replacing any previous mapping; returns false if it cannot be opened or is empty
+    bool Open(const char* file);
+    // Unmap the file
+    void Close();
+
+    const unsigned char* Data() const { return this->data; }
+    std::size_t Size() const { return this->size; }
+
+private:
+    const unsigned char* data{ nullptr };
+    std::size_t size{ 0 };
+#ifdef _WIN32
+    void* file{ nullptr };
+    void* mapping{ nullptr };
+#endif
+};
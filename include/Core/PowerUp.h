@@ -1,23 +1,51 @@
 #pragma once
+
 #include "GameObject.h"
 
+class GameSim;
+
 const glm::vec2 SIZE{ 60.0f, 20.0f };
 const glm::vec2 VELOCITY{ 0.0f, 150.0f };
 
+// Power-up kinds, in spawn roll order; indexes POWER_UP_KINDS
+enum PowerUpType
+{
+    POWERUP_SPEED,
+    POWERUP_STICKY,
+    POWERUP_PASS_THROUGH,
+    POWERUP_PAD_SIZE_INCREASE,
+    POWERUP_CONFUSE,
+    POWERUP_CHAOS,
+    POWERUP_MULTI_BALL,
+    POWERUP_TYPE_COUNT
+};
+
+// Everything that differs between power-up kinds. Kinds with a duration stay active until their timer runs out; the
+// effect is only deactivated once the last active power-up of that kind expires.
+struct PowerUpKind
+{
+    glm::vec3 Color;
+    // Seconds the effect lasts, 0 for instant effects that are never deactivated
+    float Duration;
+    // Spawns with a chance of 1 in SpawnChance per destroyed brick
+    unsigned int SpawnChance;
+    // Atlas region name, resolved by the presentation layer
+    const char* Region;
+    void (*Activate)(GameSim& sim);
+    void (*Deactivate)(GameSim& sim);
+};
+
+extern const PowerUpKind POWER_UP_KINDS[POWERUP_TYPE_COUNT];
+
 class PowerUp :
     public GameObject
 {
 public:
-    PowerUp(std::string type, glm::vec3 color, float duration, glm::vec2 position, Texture2D texture)
-        : GameObject(position, SIZE, texture, color, VELOCITY)
+    PowerUp(PowerUpType type, glm::vec2 position)
+        : GameObject(position, SIZE, POWER_UP_KINDS[type].Color, VELOCITY)
         , Type{ type }
-        , Duration{ duration }
-        , Activated{ false }
     {}
 
 public:
-    std::string Type;
-    float Duration;
-    bool Activated;
+    PowerUpType Type;
 };
-
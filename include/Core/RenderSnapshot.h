@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "GameSim.h"
+
+// A moving object at the end of a tick, with where it was at the start of it
+struct ObjectSnapshot
+{
+    glm::vec2 PreviousPosition;
+    glm::vec2 Position;
+    glm::vec2 Size;
+    glm::vec2 Velocity;
+    glm::vec3 Color;
+    float Rotation;
+};
+
+struct PowerUpSnapshot
+{
+    ObjectSnapshot Object;
+    PowerUpType Type;
+};
+
+// Everything the presentation layer draws, copied out of the simulation after a tick so the two can run on separate
+// threads. Only live power-ups are included.
+struct RenderSnapshot
+{
+    // Copy the drawable state of the sim as of the given tick, which ended at 'time' seconds
+    void Capture(const GameSim& sim, unsigned long long tick, double time);
+
+    unsigned long long Tick{ 0 };
+    double Time{ 0.0 };
+
+    GameState State{ GAME_ACTIVE };
+    ObjectSnapshot Player{};
+    std::vector<ObjectSnapshot> Balls;
+    float BallRadius{ 0.0f };
+    // Bricks of the current level. Their layout is fixed per level, so it is only copied when the level changed since
+    // this snapshot was last captured; otherwise only the destroyed flags are.
+    BrickField Bricks;
+    unsigned int LevelVersion{ 0 };
+    std::vector<PowerUpSnapshot> PowerUps;
+
+    // Effect flags
+    bool Confuse{ false };
+    bool Chaos{ false };
+    bool Shake{ false };
+};
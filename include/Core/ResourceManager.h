@@ -1,28 +1,79 @@
 #pragma once
+#include <cassert>
+#include <deque>
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 #include <Rendering/Texture.h>
 #include <Rendering/Shader.h>
+#include <Rendering/TextureAtlas.h>
+#include "MappedFile.h"
+#include "TextureCache.h"
+// Index of a loaded resource of type T. Handles are handed out when a resource is loaded or queued, stay valid until
+// Clear, and resolve with a plain array access.
+template <typename T>
+struct ResourceHandle
+{
+    unsigned int Index{ ~0u };
+
+    bool Valid() const { return this->Index != ~0u; }
+};
+
+typedef ResourceHandle<Shader> ShaderHandle;
+typedef ResourceHandle<Texture2D> TextureHandle;
+typedef ResourceHandle<TextureAtlas> AtlasHandle;
+
 class ResourceManager
 {
 public:
-    // Resource storage
-    static std::map<std::string, Shader> Shaders;
-    static std::map<std::string, Texture2D> Textures;
-
     // Loads and generates a shader program from file loading vertex, fragment (and geometry) shader's source code. If geometry shader is not nullptr, it is also loaded
-    static Shader LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name);
+    static ShaderHandle LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name);
 
     // Retrieves a stored shader
-    static Shader& GetShader(std::string name);
+    static Shader& GetShader(ShaderHandle handle)
+    {
+        assert(handle.Valid() && handle.Index < shaders.size());
+        return shaders[handle.Index];
+    }
 
     // Loads and generates a texture from file
-    static Texture2D LoadTexture(const char* file, bool alpha, std::string name);
+    static TextureHandle LoadTexture(const char* file, bool alpha, std::string name);
 
     // Retrieves a stored texture
-    static Texture2D& GetTexture(std::string name);
+    static Texture2D& GetTexture(TextureHandle handle)
+    {
+        assert(handle.Valid() && handle.Index < textures.size());
+        return textures[handle.Index];
+    }
+
+    // Loads images from file and packs them into one atlas texture; each image becomes a region named by its pair's name
+    static AtlasHandle LoadAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name);
+
+    // Retrieves a stored atlas, finishing its load first if it was queued lazily
+    static TextureAtlas& GetAtlas(AtlasHandle handle);
+
+    // Asynchronous loading: the Queue functions start reading and decoding files on worker threads right away, and
+    // FinishLoading does the GL work on the calling thread as each result arrives, returning once all are stored
+    static ShaderHandle QueueShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name);
+    static TextureHandle QueueTexture(const char* file, bool alpha, std::string name);
+    static AtlasHandle QueueAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name);
+    static void FinishLoading();
+
+    // Starts decoding an atlas in the background without waiting for it; it is uploaded on the first GetAtlas. Its
+    // region names can be resolved right away.
+    static AtlasHandle QueueLazyAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name);
+
+    // Index of a region inside an atlas; works for lazy atlases without building them
+    static unsigned int FindRegion(AtlasHandle atlas, const std::string& name)
+    {
+        assert(atlas.Valid() && atlas.Index < atlases.size());
+        return atlases[atlas.Index].FindRegion(name);
+    }
 
     // Properly de-allocates all loaded resources
     static void Clear();
@@ -31,10 +82,74 @@ private:
     // Private constructor, that is we do not want any actual resource manager objects. Its memory is static and globally available.
     ResourceManager() {}
 
+    // File contents produced by the workers
+    struct ShaderSources
+    {
+        std::string Vertex, Fragment, Geometry;
+        bool HasGeometry{ false };
+    };
+    struct DecodedImage
+    {
+        std::string Name;
+        int Width{ 0 }, Height{ 0 }, Channels{ 0 };
+        // Pixels come either from the decoder or straight from a mapped texture cache file
+        std::vector<unsigned char> Pixels;
+        std::unique_ptr<MappedFile> Cache;
+
+        const unsigned char* Data() const { return this->Cache ? this->Cache->Data() + sizeof(TextureCacheHeader) : this->Pixels.data(); }
+        bool Valid() const { return this->Width > 0 && this->Height > 0; }
+    };
+
+    // Loads still in flight
+    struct PendingShader
+    {
+        unsigned int Index;
+        std::future<ShaderSources> Sources;
+    };
+    struct PendingTexture
+    {
+        unsigned int Index;
+        bool Alpha;
+        std::future<DecodedImage> Image;
+    };
+    struct PendingAtlas
+    {
+        unsigned int Index;
+        std::vector<std::future<DecodedImage>> Images;
+    };
+    static std::vector<PendingShader> pendingShaders;
+    static std::vector<PendingTexture> pendingTextures;
+    static std::vector<PendingAtlas> pendingAtlases;
+    static std::map<unsigned int, PendingAtlas> lazyAtlases;
+
+    // Resource storage; deques keep references stable as resources are added
+    static std::deque<Shader> shaders;
+    static std::deque<Texture2D> textures;
+    static std::deque<TextureAtlas> atlases;
+    // Set for atlases still waiting in lazyAtlases
+    static std::vector<bool> atlasPending;
+
+    // Name to index, only used while loading
+    static std::map<std::string, unsigned int> shaderNames;
+    static std::map<std::string, unsigned int> textureNames;
+    static std::map<std::string, unsigned int> atlasNames;
+
     // Loads and generates a shader from file
     static Shader loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile = nullptr);
 
     // Loads a single texture from file
     static Texture2D loadTextureFromFile(const char* file, bool alpha);
+
+    // Thread-safe file stages
+    static ShaderSources readShaderSources(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile);
+    static DecodedImage decodeImage(const char* file, std::string name, int channels);
+    static std::vector<std::future<DecodedImage>> decodeAtlasImages(const std::vector<std::pair<const char*, std::string>>& files);
+
+    // GL stages, main thread only
+    static Shader compileShader(const ShaderSources& sources);
+    static Texture2D createTexture(const DecodedImage& image, bool alpha);
+    static void buildAtlas(unsigned int index, const std::vector<DecodedImage>& images);
+    // Declares every image of an atlas as a region, so region names resolve before the atlas is built
+    static unsigned int createAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name);
 };
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Rendering/Shader.h>
+
+// Header of a cached program binary; the binary follows it
+struct ShaderCacheHeader
+{
+    char Magic[4];              // "SPRG"
+    std::uint32_t Version;      // SHADER_CACHE_VERSION
+    std::uint32_t Format;       // Binary format reported by the driver
+    std::uint32_t Length;       // Binary size in bytes
+    std::uint64_t SourceHash;   // Hash of all stage sources
+    std::uint64_t DriverHash;   // Hash of the GL vendor, renderer and version strings
+};
+
+const std::uint32_t SHADER_CACHE_VERSION = 1;
+
+// Directory holding the cached program binaries
+const char* const SHADER_CACHE_DIRECTORY = "cache/shaders";
+
+// Hash of the current GL driver; binaries from another driver are never loaded
+std::uint64_t ShaderDriverHash();
+
+// Creates the program from its cached binary if one exists for these sources and this driver
+bool LoadCachedProgram(std::uint64_t sourceHash, Shader& shader);
+
+// Stores the binary of a linked program for the next launch
+bool StoreCachedProgram(std::uint64_t sourceHash, const Shader& shader);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "MappedFile.h"
+
+// Header of a cached, already decoded image; the pixels follow it, row by row, Channels bytes each
+struct TextureCacheHeader
+{
+    char Magic[4];              // "TCCH"
+    std::uint32_t Version;      // TEXTURE_CACHE_VERSION
+    std::uint32_t Width;
+    std::uint32_t Height;
+    std::uint32_t Channels;
+    std::uint32_t Reserved;
+    std::uint64_t SourceHash;   // HashFile of the image the pixels were decoded from
+};
+
+const std::uint32_t TEXTURE_CACHE_VERSION = 1;
+
+// Directory holding the cached images
+const char* const TEXTURE_CACHE_DIRECTORY = "cache/textures";
+
+// 64-bit FNV-1a hash of a file's contents; returns false if it cannot be read
+bool HashFile(const char* file, std::uint64_t& hash);
+
+// Path of the cache file for an image decoded with the given number of channels (0 = as stored)
+std::string TextureCachePath(const char* source, int channels);
+
+// Maps the cache file of an image if it exists and was decoded from a file with the given hash
+bool LoadCachedImage(const char* source, int channels, std::uint64_t sourceHash, MappedFile& cache, TextureCacheHeader& header);
+
+// Writes the cache file of an image; the file is written under a temporary name and renamed into place
+bool StoreCachedImage(const char* source, int channels, std::uint64_t sourceHash,
+    int width, int height, int pixelChannels, const unsigned char* pixels);
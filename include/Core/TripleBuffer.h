@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+// Hands the newest value from one producer thread to one consumer thread without locks or waiting. Each side owns one
+// of three slots and swaps it with the shared middle slot: the producer after filling its slot, the consumer when it
+// wants something newer. Values the consumer never picked up are overwritten. Slots are reused, so a T holding
+// vectors keeps their capacity.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Producer: the slot to fill next
+    T& Back() { return this->slots[this->back]; }
+    // Producer: make the filled slot the newest value and take over the one it replaces
+    void Publish()
+    {
+        unsigned int previous = this->middle.exchange(this->back | FRESH, std::memory_order_acq_rel);
+        this->back = previous & INDEX;
+    }
+
+    // Consumer: switch to the newest published value, if there is one since the last call; returns whether it did
+    bool Acquire()
+    {
+        if (!(this->middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+
+        unsigned int previous = this->middle.exchange(this->front, std::memory_order_acq_rel);
+        this->front = previous & INDEX;
+        return true;
+    }
+    // Consumer: the value acquired last
+    const T& Front() const { return this->slots[this->front]; }
+
+private:
+    // The middle slot index, with FRESH set while it holds a value the consumer has not taken yet
+    static const unsigned int INDEX = 3;
+    static const unsigned int FRESH = 4;
+
+    T slots[3];
+    // Each side's index on its own cache line, away from the shared one
+    alignas(64) unsigned int back{ 0 };
+    alignas(64) std::atomic<unsigned int> middle{ 1 };
+    alignas(64) unsigned int front{ 2 };
+};
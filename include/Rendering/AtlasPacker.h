@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Pixels of padding around every image, filled with its edge pixels against filtering bleed
+const unsigned int ATLAS_PADDING{ 2 };
+
+// Placement of one image inside the atlas, in pixels
+struct AtlasRect
+{
+    unsigned int X, Y, Width, Height;
+};
+
+// Packs the given image sizes into shelves, tallest first, leaving 'padding' pixels around every image. Tries each
+// power-of-two atlas width up to maxWidth and keeps the smallest power-of-two area. Ties in the ordering are broken
+// by input index, so the result only depends on the input. Returns false if the images do not fit.
+bool PackAtlas(const std::vector<glm::uvec2>& sizes, unsigned int padding, unsigned int maxWidth, unsigned int maxHeight,
+    std::vector<AtlasRect>& rects, glm::uvec2& atlasSize);
+
+// Copies tightly packed RGBA8 images into an atlas of the given size at their packed rects and extrudes their edge
+// pixels into the padding around them. Pixels outside every padded rect are left zero.
+std::vector<unsigned char> ComposeAtlas(const std::vector<const unsigned char*>& images, const std::vector<AtlasRect>& rects,
+    unsigned int padding, glm::uvec2 atlasSize);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Uniform buffer binding of the 'Frame' block declared by the shaders
+const unsigned int FRAME_UNIFORM_BINDING = 0;
+
+// Values shared by every shader, uploaded once per frame into a std140 uniform block:
+//   layout (std140, binding = 0) uniform Frame { mat4 projection; float time; };
+class FrameUniforms
+{
+public:
+    FrameUniforms();
+    ~FrameUniforms();
+
+    // Upload the current values; the buffer stays bound to FRAME_UNIFORM_BINDING
+    void Upload();
+
+public:
+    glm::mat4 Projection;
+    float Time;
+
+private:
+    // Mirrors the std140 layout of the block
+    struct Block
+    {
+        glm::mat4 Projection;
+        float Time;
+        float Padding[3];
+    };
+
+    unsigned int UBO;
+};
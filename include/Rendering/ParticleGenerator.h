@@ -2,42 +2,53 @@
 
 #include <vector>
 
+#include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include <Core/GameObject.h>
+#include "ParticlePool.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
 
-struct Particle
+// Per-instance particle data, matching the instance attributes of particle.vert
+struct ParticleInstance
 {
-    glm::vec2 Position;
-    glm::vec2 Velocity;
+    glm::vec2 Offset;
     glm::vec4 Color;
-    float Life;
-
-    Particle()
-        : Position{ 0.0f }, Velocity{ 0.0f }, Color{ 1.0f }, Life{ 0.0f } {
-    }
 };
 
+// Number of instance buffer regions in flight, so the CPU never writes one the GPU may still read
+const unsigned int PARTICLE_BUFFER_REGIONS = 3;
+
 class ParticleGenerator
 {
 public:
-    ParticleGenerator(Shader shader, Texture2D texture, unsigned int amount);
+    ParticleGenerator(Shader shader, Texture2D texture, unsigned int amount, AtlasRegion region = AtlasRegion{});
+    ~ParticleGenerator();
     void Update(float deltaTime, GameObject& object, unsigned int newParticles, glm::vec2 offset = glm::vec2{ 0.0f, 0.0f });
     void Draw();
 
 private:
     void init();
-    unsigned int firstUnusedParticle();
-    void respawnParticle(Particle& particle, GameObject& object, glm::vec2 offset = glm::vec2{0.0f, 0.0f} );
+    void respawnParticle(GameObject& object, glm::vec2 offset = glm::vec2{0.0f, 0.0f} );
 
 private:
     // State
-    std::vector<Particle> particles;
+    ParticlePool particles;
     unsigned int amount;
     
     // Render state
     Shader shader;
     Texture2D texture;
+    AtlasRegion region;
+    int regionLocation;
     unsigned int VAO{ 0 };
+
+    // Persistently mapped instance buffer, split into PARTICLE_BUFFER_REGIONS regions of 'amount' instances
+    unsigned int instanceVBO{ 0 };
+    ParticleInstance* instances{ nullptr };
+    GLsync fences[PARTICLE_BUFFER_REGIONS]{};
+    unsigned int currentRegion{ 0 };
 };
 
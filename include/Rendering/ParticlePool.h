@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Number of particles advanced per kernel iteration: AVX when the compiler targets it, SSE on x86/x64, scalar otherwise
+#if defined(__AVX__)
+const unsigned int PARTICLE_LANES = 8;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+const unsigned int PARTICLE_LANES = 4;
+#else
+const unsigned int PARTICLE_LANES = 1;
+#endif
+
+// Fixed-capacity particles in structure-of-arrays layout. Live particles always occupy [0, Count()): spawning appends
+// and retiring moves the last live particle into the freed slot, so both are O(1) and the kernel never visits holes.
+class ParticlePool
+{
+public:
+    ParticlePool(unsigned int capacity);
+
+    // Add a particle; when the pool is full the oldest slots are overwritten in turn
+    void Spawn(glm::vec2 position, glm::vec2 velocity, glm::vec4 color, float life);
+    // Advance all particles, in parallel on the job system for large pools, and retire the ones that died
+    void Update(float deltaTime);
+    // Advance the particles in [first, last) without retiring any. Both bounds must be multiples of PARTICLE_LANES,
+    // except a 'last' equal to Count(); such disjoint ranges may be updated from different threads.
+    void UpdateRange(unsigned int first, unsigned int last, float deltaTime);
+    // Remove dead particles from the live range
+    void RetireDead();
+
+    unsigned int Count() const { return this->count; }
+    unsigned int Capacity() const { return this->capacity; }
+
+public:
+    // Storage, padded to a multiple of PARTICLE_LANES
+    std::vector<float> PositionX, PositionY;
+    std::vector<float> VelocityX, VelocityY;
+    std::vector<float> ColorR, ColorG, ColorB, ColorA;
+    std::vector<float> Life;
+
+private:
+    unsigned int count;
+    unsigned int capacity;
+    unsigned int overwrite;
+};
@@ -9,7 +9,7 @@ public:
     PostProcessor(Shader shader, unsigned int width, unsigned height);
     void BeginRender();
     void EndRender();
-    void Render(float time);
+    void Render();
 
 public:
     Shader PostProcessingShader;
@@ -25,6 +25,9 @@ private:
     void initRenderData();
 
 private:
+    // Uniform locations
+    int confuseLocation, chaosLocation, shakeLocation;
+
     unsigned int MSFBO; // Multisampled FBO. 
     unsigned int FBO;   // FBO is regular, used for blitting MS color-buffer to texture
     unsigned int RBO;   // RBO is used for multisampled color buffer
@@ -0,0 +1,45 @@
+#pragma once
+
+// Number of texture units whose bindings are tracked
+const unsigned int RENDER_STATE_TEXTURE_UNITS = 8;
+
+// State changes of one frame
+struct RenderStateStats
+{
+    unsigned int Issued{ 0 };
+    unsigned int Elided{ 0 };
+};
+
+// Shadows the bound GL objects so redundant binds never reach the driver. All rendering code binds programs,
+// textures, vertex arrays, framebuffers and blend functions through here. Debug builds read every issued bind back
+// from GL to verify it; release builds never query GL state.
+class RenderState
+{
+public:
+    static void UseProgram(unsigned int program);
+    static void BindTexture(unsigned int unit, unsigned int texture);
+    static void BindVertexArray(unsigned int vertexArray);
+    static void BindFramebuffer(unsigned int framebuffer);
+    static void BlendFunc(unsigned int source, unsigned int destination);
+
+    // Forget everything known about the GL state, e.g. after a context change or when objects are deleted
+    static void Invalidate();
+
+    // Close the current frame's counters; LastFrame holds them until the next call
+    static void BeginFrame();
+
+public:
+    static RenderStateStats LastFrame;
+
+private:
+    RenderState() {}
+
+    static RenderStateStats frame;
+
+    // Currently bound objects; an unknown binding forces the next bind through
+    static unsigned int program;
+    static unsigned int textures[RENDER_STATE_TEXTURE_UNITS];
+    static unsigned int vertexArray;
+    static unsigned int framebuffer;
+    static unsigned int blendSource, blendDestination;
+};
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <functional>
+#include <map>
 #include <string>
+#include <vector>
 
 class Shader
 {
@@ -15,6 +18,11 @@ public:
     // Compiles the shader from given source code
     void Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource = nullptr);
 
+    // Creates the program from a binary made by GetBinary; returns false if the driver rejects it
+    bool LoadBinary(unsigned int format, const void* binary, int length);
+    // Retrieves the binary of the linked program
+    bool GetBinary(unsigned int& format, std::vector<unsigned char>& binary) const;
+
     // Utility functions
     void SetFloat(const char* name, float value, bool useShader = false);
     void SetInteger(const char* name, int value, bool useShader = false);
@@ -26,11 +34,28 @@ public:
     void SetVector4f(const char* name, const glm::vec4& value, bool useShader = false);
     void SetMatrix4(const char* name, const glm::mat4& matrix, bool useShader = false);
 
+    // Returns the location of a uniform as cached at link time, -1 if the program does not use it. Resolve locations
+    // once and pass them to the setters below to keep name lookups off the per-draw path.
+    int Location(const char* name) const;
+    void SetFloat(int location, float value, bool useShader = false);
+    void SetInteger(int location, int value, bool useShader = false);
+    void SetVector2f(int location, const glm::vec2& value, bool useShader = false);
+    void SetVector3f(int location, const glm::vec3& value, bool useShader = false);
+    void SetVector4f(int location, const glm::vec4& value, bool useShader = false);
+    void SetMatrix4(int location, const glm::mat4& matrix, bool useShader = false);
+
 public:
     // State
     unsigned int ID;
 
 private:
     void checkCompileErrors(unsigned int object, std::string type);
+    // Queries the locations of all active uniforms
+    void cacheUniforms();
+
+private:
+    // Uniform locations by name; arrays are also stored under their name without "[0]". The transparent comparator
+    // lets Location look names up without building a std::string.
+    std::map<std::string, int, std::less<>> uniforms;
 };
 
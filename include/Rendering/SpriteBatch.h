@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+
+// Per-instance sprite data, matching the instance attributes of default.vert
+struct SpriteInstance
+{
+    glm::vec2 Position;
+    glm::vec2 Size;
+    glm::vec4 Color;
+    glm::vec2 TexOffset;
+    glm::vec2 TexScale;
+    float Rotation;
+};
+
+// Collects sprites into an instance buffer and draws them with one instanced call per texture run. Sprites that share
+// an atlas texture and only differ in their region end up in the same draw.
+class SpriteBatch
+{
+public:
+    SpriteBatch(Shader& shader, unsigned int capacity = 16384);
+    ~SpriteBatch();
+
+    // Start collecting sprites
+    void Begin();
+    // Queue a sprite, flushing first if the texture changes or the batch is full
+    void DrawSprite(Texture2D& texture, glm::vec2 position,
+        glm::vec2 size = glm::vec2{ 10, 10 },
+        float rotate = 0.0f,
+        glm::vec3 color = glm::vec3{ 1.0f },
+        const AtlasRegion& region = AtlasRegion{});
+    // Draw everything still queued
+    void End();
+
+private:
+    void initRenderData();
+    void flush();
+
+private:
+    Shader shader;
+    unsigned int quadVAO;
+    unsigned int instanceVBO;
+    unsigned int capacity;
+
+    // Batch state
+    std::vector<SpriteInstance> instances;
+    Texture2D* texture;
+};
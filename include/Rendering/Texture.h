@@ -6,10 +6,10 @@ public:
     Texture2D();
 
     // Generate texture from file
-    void Generate(unsigned int width, unsigned int height, unsigned char* data);
+    void Generate(unsigned int width, unsigned int height, const unsigned char* data);
 
-    // Bind texture
-    void Bind() const;
+    // Bind texture to the given texture unit
+    void Bind(unsigned int unit = 0) const;
 
 public:
     // Holds the ID of the texture
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AtlasPacker.h"
+#include "Texture.h"
+
+// Normalized texture coordinates of one image inside the atlas
+struct AtlasRegion
+{
+    glm::vec2 Offset{ 0.0f, 0.0f };
+    glm::vec2 Scale{ 1.0f, 1.0f };
+};
+
+// Combines RGBA images into one texture, addressed by named regions
+class TextureAtlas
+{
+public:
+    // Reserve a region for an image name and return its index; the region is filled in by Build
+    unsigned int Declare(const std::string& name);
+    // Queue an RGBA8 image for a (possibly already declared) region; the pixels are copied
+    void Add(const std::string& name, const unsigned char* pixels, unsigned int width, unsigned int height);
+    // Pack the queued images and upload the atlas texture
+    bool Build(unsigned int maxSize = 4096);
+    // Index of a region by image name, for use at load time. An unknown name is a bug in the game's asset lists, so it
+    // is reported and aborts right there rather than drawing the wrong image later.
+    unsigned int FindRegion(const std::string& name) const;
+    // Retrieves a region by index
+    const AtlasRegion& GetRegion(unsigned int index) const
+    {
+        assert(index < this->Regions.size());
+        return this->Regions[index];
+    }
+
+public:
+    Texture2D Texture;
+    // Regions by index, each covering the full texture until Build places its image
+    std::vector<AtlasRegion> Regions;
+
+private:
+    // Images waiting for Build
+    struct Image
+    {
+        unsigned int Region;
+        std::vector<unsigned char> Pixels;
+        unsigned int Width, Height;
+    };
+    std::vector<Image> images;
+    std::map<std::string, unsigned int> regionNames;
+};
@@ -5,8 +5,8 @@ BallObject::BallObject()
 {
 }
 
-BallObject::BallObject(glm::vec2 position, float radius, glm::vec2 velocity, Texture2D sprite)
-    : GameObject(position, glm::vec2{ radius * 2.0f, radius * 2.0f }, sprite, glm::vec3{ 1.0f }, velocity)
+BallObject::BallObject(glm::vec2 position, float radius, glm::vec2 velocity)
+    : GameObject(position, glm::vec2{ radius * 2.0f, radius * 2.0f }, glm::vec3{ 1.0f }, velocity)
     , Radius{ radius }
     , Stuck{ true }
     , Sticky{ false }
@@ -14,35 +14,6 @@ BallObject::BallObject(glm::vec2 position, float radius, glm::vec2 velocity, Tex
 {
 }
 
-glm::vec2 BallObject::Move(float deltaTime, unsigned int windowWidth)
-{
-    // If not stuck to player paddle
-    if (!this->Stuck)
-    {
-        // Move the ball
-        this->Position += this->Velocity * deltaTime;
-
-        // Then check if outside window bounds and if so, reverse velocity and restore at correct position
-        if (this->Position.x <= 0.0f)
-        {
-            this->Velocity.x = -this->Velocity.x;
-            this->Position.x = 0.0f;
-        }
-        else if (this->Position.x + this->Size.x >= windowWidth)
-        {
-            this->Velocity.x = -this->Velocity.x;
-            this->Position.x = windowWidth - this->Size.x;
-        }
-        if (this->Position.y <= 0.0f)
-        {
-            this->Velocity.y = -this->Velocity.y;
-            this->Position.y = 0.0f;
-        }
-    }
-
-    return this->Position;
-}
-
 // Resets the ball to initial Stuck position
 void BallObject::Reset(glm::vec2 position, glm::vec2 velocity)
 {
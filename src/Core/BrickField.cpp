@@ -0,0 +1,79 @@
+#include "Core/BrickField.h"
+#include "Core/Hash.h"
+
+#include <algorithm>
+
+void BrickField::Clear()
+{
+    this->Positions.clear();
+    this->Sizes.clear();
+    this->ColorIndices.clear();
+    this->destroyed.clear();
+    this->solid.clear();
+    this->destructible = 0;
+    this->remaining = 0;
+}
+
+void BrickField::Reserve(unsigned int count)
+{
+    this->Positions.reserve(count);
+    this->Sizes.reserve(count);
+    this->ColorIndices.reserve(count);
+    this->destroyed.reserve((count + 63) / 64);
+    this->solid.reserve((count + 63) / 64);
+}
+
+unsigned int BrickField::Add(glm::vec2 position, glm::vec2 size, bool solid, unsigned char colorIndex)
+{
+    unsigned int index = this->Count();
+
+    // Start a new bitset word every 64 bricks
+    if ((index & 63) == 0)
+    {
+        this->destroyed.push_back(0);
+        this->solid.push_back(0);
+    }
+
+    this->Positions.push_back(position);
+    this->Sizes.push_back(size);
+    this->ColorIndices.push_back(colorIndex);
+    if (solid)
+    {
+        this->solid[index >> 6] |= std::uint64_t{ 1 } << (index & 63);
+    }
+    else
+    {
+        ++this->destructible;
+        ++this->remaining;
+    }
+
+    return index;
+}
+
+void BrickField::Restore()
+{
+    std::fill(this->destroyed.begin(), this->destroyed.end(), std::uint64_t{ 0 });
+    this->remaining = this->destructible;
+}
+
+void BrickField::CopyDestroyed(const BrickField& other)
+{
+    this->destroyed = other.destroyed;
+    this->remaining = other.remaining;
+}
+
+void BrickField::Destroy(unsigned int index)
+{
+    std::uint64_t bit = std::uint64_t{ 1 } << (index & 63);
+    if (!(this->destroyed[index >> 6] & bit) && !this->IsSolid(index))
+    {
+        --this->remaining;
+    }
+
+    this->destroyed[index >> 6] |= bit;
+}
+
+std::uint64_t BrickField::Hash(std::uint64_t hash) const
+{
+    return HashBytes(this->destroyed.data(), this->destroyed.size() * sizeof(std::uint64_t), hash);
+}
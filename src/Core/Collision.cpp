@@ -0,0 +1,270 @@
+#include "Core/Collision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+// Position of the padding boxes, far enough away to never collide
+const float PADDING_POSITION{ -1.0e30f };
+// Widening of the boxes in the vector prefilter, in pixels; well above the rounding error of the slab test
+const float SWEEP_MARGIN{ 0.01f };
+
+void BoxBatch::Clear()
+{
+    this->X.clear();
+    this->Y.clear();
+    this->Width.clear();
+    this->Height.clear();
+    this->count = 0;
+}
+
+void BoxBatch::Add(glm::vec2 position, glm::vec2 size)
+{
+    // Grow by a whole block of padding boxes so the prefilter never reads past the end
+    if (this->count % COLLISION_LANES == 0)
+    {
+        this->X.resize(this->count + COLLISION_LANES, PADDING_POSITION);
+        this->Y.resize(this->count + COLLISION_LANES, PADDING_POSITION);
+        this->Width.resize(this->count + COLLISION_LANES, 0.0f);
+        this->Height.resize(this->count + COLLISION_LANES, 0.0f);
+    }
+
+    this->X[this->count] = position.x;
+    this->Y[this->count] = position.y;
+    this->Width[this->count] = size.x;
+    this->Height[this->count] = size.y;
+    ++this->count;
+}
+
+bool CheckCollision(GameObject& one, GameObject& two)
+{
+    // collision x-axis?
+    bool collisionX = one.Position.x + one.Size.x >= two.Position.x &&
+        two.Position.x + two.Size.x >= one.Position.x;
+    // collision y-axis?
+    bool collisionY = one.Position.y + one.Size.y >= two.Position.y &&
+        two.Position.y + two.Size.y >= one.Position.y;
+    // collision only if on both axes
+    return collisionX && collisionY;
+}
+
+bool SweepCircle(glm::vec2 center, float radius, glm::vec2 motion, glm::vec2 position, glm::vec2 size, SweepHit& hit)
+{
+    glm::vec2 boxMin{ position };
+    glm::vec2 boxMax{ position + size };
+
+    // Already overlapping: push out along the shortest way, but only if the circle is not leaving anyway
+    glm::vec2 closest{ glm::clamp(center, boxMin, boxMax) };
+    glm::vec2 difference{ center - closest };
+    float distanceSquared = glm::dot(difference, difference);
+    if (distanceSquared < radius * radius)
+    {
+        glm::vec2 normal;
+        if (distanceSquared > 0.0f)
+        {
+            normal = difference / std::sqrt(distanceSquared);
+        }
+        else
+        {
+            // Center inside the box: leave through the nearest side
+            glm::vec2 toMin{ center - boxMin };
+            glm::vec2 toMax{ boxMax - center };
+            float nearest = std::min(std::min(toMin.x, toMax.x), std::min(toMin.y, toMax.y));
+            normal = nearest == toMin.x ? glm::vec2{ -1.0f, 0.0f } : nearest == toMax.x ? glm::vec2{ 1.0f, 0.0f } :
+                nearest == toMin.y ? glm::vec2{ 0.0f, -1.0f } : glm::vec2{ 0.0f, 1.0f };
+        }
+
+        if (glm::dot(motion, normal) >= 0.0f)
+        {
+            return false;
+        }
+        hit = SweepHit{ 0.0f, normal };
+        return true;
+    }
+
+    // Cast the center against the box widened by the radius (slab test)
+    glm::vec2 expandedMin{ boxMin - radius };
+    glm::vec2 expandedMax{ boxMax + radius };
+    float enter = -1.0e30f, exit = 1.0e30f;
+    int axis = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (motion[i] == 0.0f)
+        {
+            if (center[i] < expandedMin[i] || center[i] > expandedMax[i])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float nearTime = (expandedMin[i] - center[i]) / motion[i];
+        float farTime = (expandedMax[i] - center[i]) / motion[i];
+        if (nearTime > farTime)
+        {
+            std::swap(nearTime, farTime);
+        }
+        if (nearTime > enter)
+        {
+            enter = nearTime;
+            axis = i;
+        }
+        exit = std::min(exit, farTime);
+    }
+
+    if (enter > exit || enter > 1.0f || exit < 0.0f)
+    {
+        return false;
+    }
+
+    // Entering through a side: the widened box is exact there
+    glm::vec2 point{ center + std::max(enter, 0.0f) * motion };
+    int other = 1 - axis;
+    if (enter >= 0.0f && point[other] >= boxMin[other] && point[other] <= boxMax[other])
+    {
+        glm::vec2 normal{ 0.0f };
+        normal[axis] = motion[axis] > 0.0f ? -1.0f : 1.0f;
+        hit = SweepHit{ enter, normal };
+        return true;
+    }
+
+    // Entering through a corner square: the rounded corner is a circle of the radius around the box corner
+    glm::vec2 corner{ point.x < boxMin.x ? boxMin.x : boxMax.x, point.y < boxMin.y ? boxMin.y : boxMax.y };
+    glm::vec2 offset{ center - corner };
+    float a = glm::dot(motion, motion);
+    float b = glm::dot(offset, motion);
+    float c = glm::dot(offset, offset) - radius * radius;
+    float discriminant = b * b - a * c;
+    if (b >= 0.0f || discriminant < 0.0f)
+    {
+        return false;
+    }
+
+    float time = (-b - std::sqrt(discriminant)) / a;
+    if (time > 1.0f)
+    {
+        return false;
+    }
+
+    time = std::max(time, 0.0f);
+    hit = SweepHit{ time, glm::normalize(center + time * motion - corner) };
+    return true;
+}
+
+// The prefilters below run a slab test of the motion against each box of a block, widened by the radius plus
+// SWEEP_MARGIN, and return a bit per lane that passes. Widening by the margin makes them pass every box the exact
+// SweepCircle can hit, rounding included; the few extra ones are rejected by the exact test.
+#if defined(__AVX2__)
+
+static unsigned int sweepCandidates(glm::vec2 center, float reach, glm::vec2 motion, const BoxBatch& boxes, unsigned int base)
+{
+    const float* positions[2]{ &boxes.X[base], &boxes.Y[base] };
+    const float* sizes[2]{ &boxes.Width[base], &boxes.Height[base] };
+
+    __m256 enter = _mm256_set1_ps(-1.0e30f);
+    __m256 exit = _mm256_set1_ps(1.0e30f);
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int i = 0; i < 2; ++i)
+    {
+        __m256 expandedMin = _mm256_sub_ps(_mm256_loadu_ps(positions[i]), _mm256_set1_ps(reach));
+        __m256 expandedMax = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(positions[i]), _mm256_loadu_ps(sizes[i])), _mm256_set1_ps(reach));
+        __m256 start = _mm256_set1_ps(center[i]);
+
+        // The motion is the same for every lane: without any along this axis the center has to start within the slab
+        if (motion[i] == 0.0f)
+        {
+            inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(expandedMin, start, _CMP_LE_OQ), _mm256_cmp_ps(start, expandedMax, _CMP_LE_OQ)));
+            continue;
+        }
+
+        __m256 step = _mm256_set1_ps(motion[i]);
+        __m256 nearTime = _mm256_div_ps(_mm256_sub_ps(expandedMin, start), step);
+        __m256 farTime = _mm256_div_ps(_mm256_sub_ps(expandedMax, start), step);
+        enter = _mm256_max_ps(enter, _mm256_min_ps(nearTime, farTime));
+        exit = _mm256_min_ps(exit, _mm256_max_ps(nearTime, farTime));
+    }
+
+    __m256 hits = _mm256_and_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ),
+        _mm256_and_ps(_mm256_cmp_ps(enter, _mm256_set1_ps(1.0f), _CMP_LE_OQ), _mm256_cmp_ps(exit, _mm256_setzero_ps(), _CMP_GE_OQ)));
+    return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(hits, inside)));
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+static unsigned int sweepCandidates(glm::vec2 center, float reach, glm::vec2 motion, const BoxBatch& boxes, unsigned int base)
+{
+    const float* positions[2]{ &boxes.X[base], &boxes.Y[base] };
+    const float* sizes[2]{ &boxes.Width[base], &boxes.Height[base] };
+
+    __m128 enter = _mm_set1_ps(-1.0e30f);
+    __m128 exit = _mm_set1_ps(1.0e30f);
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = 0; i < 2; ++i)
+    {
+        __m128 expandedMin = _mm_sub_ps(_mm_loadu_ps(positions[i]), _mm_set1_ps(reach));
+        __m128 expandedMax = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(positions[i]), _mm_loadu_ps(sizes[i])), _mm_set1_ps(reach));
+        __m128 start = _mm_set1_ps(center[i]);
+
+        // The motion is the same for every lane: without any along this axis the center has to start within the slab
+        if (motion[i] == 0.0f)
+        {
+            inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(expandedMin, start), _mm_cmple_ps(start, expandedMax)));
+            continue;
+        }
+
+        __m128 step = _mm_set1_ps(motion[i]);
+        __m128 nearTime = _mm_div_ps(_mm_sub_ps(expandedMin, start), step);
+        __m128 farTime = _mm_div_ps(_mm_sub_ps(expandedMax, start), step);
+        enter = _mm_max_ps(enter, _mm_min_ps(nearTime, farTime));
+        exit = _mm_min_ps(exit, _mm_max_ps(nearTime, farTime));
+    }
+
+    __m128 hits = _mm_and_ps(_mm_cmple_ps(enter, exit), _mm_and_ps(_mm_cmple_ps(enter, _mm_set1_ps(1.0f)), _mm_cmpge_ps(exit, _mm_setzero_ps())));
+    return static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(hits, inside)));
+}
+
+#else
+
+// Without vector instructions the exact test is about as cheap as a prefilter would be
+static unsigned int sweepCandidates(glm::vec2, float, glm::vec2, const BoxBatch&, unsigned int)
+{
+    return 1u;
+}
+
+#endif
+
+unsigned int SweepCircle(glm::vec2 center, float radius, glm::vec2 motion, const BoxBatch& boxes, unsigned int first, unsigned int last, SweepHit& hit)
+{
+    unsigned int best = last;
+    SweepHit candidate;
+    for (unsigned int base = first - first % COLLISION_LANES; base < last; base += COLLISION_LANES)
+    {
+        unsigned int lanes = sweepCandidates(center, radius + SWEEP_MARGIN, motion, boxes, base);
+
+        // Ignore lanes before 'first' and from 'last' on
+        if (base < first)
+            lanes &= ~((1u << (first - base)) - 1);
+        if (last - base < COLLISION_LANES)
+            lanes &= (1u << (last - base)) - 1;
+
+        // Exact test of the lanes left, in order, so ties still go to the lower index
+        for (unsigned int lane = 0; lanes != 0; ++lane, lanes >>= 1)
+        {
+            unsigned int i = base + lane;
+            if ((lanes & 1) && SweepCircle(center, radius, motion, glm::vec2{ boxes.X[i], boxes.Y[i] }, glm::vec2{ boxes.Width[i], boxes.Height[i] }, candidate) &&
+                (best == last || candidate.Time < hit.Time))
+            {
+                best = i;
+                hit = candidate;
+            }
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,28 @@
+#include "Core/FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(double tickLength, unsigned int maxCatchUpTicks)
+    : tickLength{ tickLength }
+    , maxCatchUpTicks{ maxCatchUpTicks }
+{
+}
+
+unsigned int FixedTimestep::Advance(double elapsed)
+{
+    this->accumulator += elapsed;
+
+    unsigned int count = 0;
+    while (this->accumulator >= this->tickLength && count < this->maxCatchUpTicks)
+    {
+        this->accumulator -= this->tickLength;
+        ++count;
+    }
+
+    // Drop whatever could not be caught up, keeping only the partial tick
+    if (this->accumulator >= this->tickLength)
+    {
+        this->accumulator -= static_cast<unsigned long long>(this->accumulator / this->tickLength) * this->tickLength;
+    }
+
+    this->ticks += count;
+    return count;
+}
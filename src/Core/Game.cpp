@@ -1,543 +1,254 @@
 #include "Core/Game.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+
 #include<glm/gtc/matrix_transform.hpp>
 
 #include <Core/ResourceManager.h>
-#include <Core/BallObject.h>
-#include <Rendering/SpriteRenderer.h>
+#include <Rendering/FrameUniforms.h>
+#include <Rendering/SpriteBatch.h>
 #include <Rendering/ParticleGenerator.h>
 #include <Rendering/PostProcessor.h>
 
 // Game-related State data
-SpriteRenderer* Renderer;
+SpriteBatch* Renderer;
 // Particles
 ParticleGenerator* Particles;
-// Player game objec
-GameObject* Player;
-// Ball game object
-BallObject* Ball;
 // Postprocessing
 PostProcessor* Effects;
+// Per-frame shader uniforms
+FrameUniforms* Frame;
 
-float ShakeTime = 0.0f;
+// Resources drawn every frame, resolved once at load time
+TextureHandle Background;
+AtlasHandle SpriteAtlas, PowerUpAtlas;
+unsigned int BlockRegion, BlockSolidRegion, PaddleRegion, FaceRegion;
+unsigned int PowerUpRegions[POWERUP_TYPE_COUNT];
 
 Game::Game(unsigned int width, unsigned int height)
-    : State(GameState::GAME_ACTIVE), Keys(), Width(width), Height(height)
+    : Keys(), Width(width), Height(height), Sim(width, height), Clock(SIM_TICK)
 {
 }
 
 Game::~Game()
 {
+    this->Stop();
     delete Renderer;
-    delete Player;
-    delete Ball;
     delete Particles;
+    delete Effects;
+    delete Frame;
 }
 
 void Game::Init()
 {
-    // Load shaders
-    ResourceManager::LoadShader("assets/shaders/default.vert", "assets/shaders/default.frag", nullptr, "sprite");
-    ResourceManager::LoadShader("assets/shaders/particle.vert", "assets/shaders/particle.frag", nullptr, "particle");
-    ResourceManager::LoadShader("assets/shaders/postprocess.vert", "assets/shaders/postprocess.frag", nullptr, "postprocess");
+    // Load shaders and textures; files are read and decoded in parallel while this thread uploads them.
+    // Everything but the full-screen background shares one atlas.
+    ShaderHandle spriteShader = ResourceManager::QueueShader("assets/shaders/default.vert", "assets/shaders/default.frag", nullptr, "sprite");
+    ShaderHandle particleShader = ResourceManager::QueueShader("assets/shaders/particle.vert", "assets/shaders/particle.frag", nullptr, "particle");
+    ShaderHandle postprocessShader = ResourceManager::QueueShader("assets/shaders/postprocess.vert", "assets/shaders/postprocess.frag", nullptr, "postprocess");
+    Background = ResourceManager::QueueTexture("assets/textures/background.jpg", false, "background");
+    SpriteAtlas = ResourceManager::QueueAtlas({
+        { "assets/textures/particle.png", "particle" },
+        { "assets/textures/paddle.png", "paddle" },
+        { "assets/textures/awesomeface.png", "face" },
+        { "assets/textures/block.png", "block" },
+        { "assets/textures/block_solid.png", "block_solid" }
+    }, "sprites");
+    ResourceManager::FinishLoading();
+
+    // Power-ups only show up once bricks break: decode them in the background, upload on first draw
+    PowerUpAtlas = ResourceManager::QueueLazyAtlas({
+        { "assets/textures/powerup_chaos.png", "powerup_chaos" },
+        { "assets/textures/powerup_confuse.png", "powerup_confuse" },
+        { "assets/textures/powerup_increase.png", "powerup_increase" },
+        { "assets/textures/powerup_multiball.png", "powerup_multiball" },
+        { "assets/textures/powerup_passthrough.png", "powerup_passthrough" },
+        { "assets/textures/powerup_speed.png", "powerup_speed" },
+        { "assets/textures/powerup_sticky.png", "powerup_sticky" }
+    }, "powerups");
 
     // Configure shaders
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->Width),
         static_cast<float>(this->Height), 0.0f, -1.0f, 1.0f);
-    ResourceManager::GetShader("sprite").Use().SetInteger("image", 0);
-    ResourceManager::GetShader("sprite").SetMatrix4("projection", projection);
-    ResourceManager::GetShader("particle").Use().SetInteger("sprite", 0);
-    ResourceManager::GetShader("particle").SetMatrix4("projection", projection);
+    ResourceManager::GetShader(spriteShader).Use().SetInteger("image", 0);
+    ResourceManager::GetShader(particleShader).Use().SetInteger("sprite", 0);
+    Frame = new FrameUniforms();
+    Frame->Projection = projection;
 
     // Set render-specific controls
-    Renderer = new SpriteRenderer(ResourceManager::GetShader("sprite"));
-
-    // Load textures
-    ResourceManager::LoadTexture("assets/textures/background.jpg", false, "background");
-    ResourceManager::LoadTexture("assets/textures/particle.png", true, "particle");
-    ResourceManager::LoadTexture("assets/textures/paddle.png", true, "paddle");
-    ResourceManager::LoadTexture("assets/textures/awesomeface.png", true, "face");
-    ResourceManager::LoadTexture("assets/textures/block.png", false, "block");
-    ResourceManager::LoadTexture("assets/textures/block_solid.png", false, "block_solid");
-    ResourceManager::LoadTexture("assets/textures/powerup_chaos.png", true, "powerup_chaos");
-    ResourceManager::LoadTexture("assets/textures/powerup_confuse.png", true, "powerup_confuse");
-    ResourceManager::LoadTexture("assets/textures/powerup_increase.png", true, "poweerup_increase");
-    ResourceManager::LoadTexture("assets/textures/powerup_passthrough.png", true, "powerup_passthrough");
-    ResourceManager::LoadTexture("assets/textures/powerup_speed.png", true, "powerup_speed");
-    ResourceManager::LoadTexture("assets/textures/powerup_sticky.png", true, "powerup_sticky");
-
-    // Load levels
-    GameLevel one; one.Load("assets/levels/one.level", this->Width, this->Height / 2);
-    GameLevel two; two.Load("assets/levels/two.level", this->Width, this->Height / 2);
-    GameLevel three; three.Load("assets/levels/three.level", this->Width, this->Height / 2);
-    GameLevel four; four.Load("assets/levels/four.level", this->Width, this->Height / 2);
-
-    this->Levels.push_back(one);
-    this->Levels.push_back(two);
-    this->Levels.push_back(three);
-    this->Levels.push_back(four);
-
-    // Player
-    glm::vec2 playerPosition{ glm::vec2{
-        this->Width / 2.0f - PLAYER_SIZE.x / 2.0f,
-        this->Height - PLAYER_SIZE.y} };
-    Player = new GameObject(playerPosition, PLAYER_SIZE, ResourceManager::GetTexture("paddle"));
-
-    // Ball
-    glm::vec2 ballPosition{ playerPosition + glm::vec2{PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -BALL_RADIUS * 2.0f} };
-    Ball = new BallObject(ballPosition, BALL_RADIUS, INITIAL_BALL_VELOCITY, ResourceManager::GetTexture("face"));
+    Renderer = new SpriteBatch(ResourceManager::GetShader(spriteShader));
+
+    // Resolve the regions drawn each frame
+    TextureAtlas& sprites = ResourceManager::GetAtlas(SpriteAtlas);
+    BlockRegion = sprites.FindRegion("block");
+    BlockSolidRegion = sprites.FindRegion("block_solid");
+    PaddleRegion = sprites.FindRegion("paddle");
+    FaceRegion = sprites.FindRegion("face");
+
+    // The power-up atlas is not built yet, but its region names are already known
+    for (unsigned int type = 0; type < POWERUP_TYPE_COUNT; ++type)
+        PowerUpRegions[type] = ResourceManager::FindRegion(PowerUpAtlas, POWER_UP_KINDS[type].Region);
+
+    // Levels, player and ball, with a fresh seed every game; recordings keep it for replays
+    this->Sim.Init(std::random_device{}());
 
     // Particles
     Particles = new ParticleGenerator(
-        ResourceManager::GetShader("particle"),
-        ResourceManager::GetTexture("particle"),
-        500
+        ResourceManager::GetShader(particleShader),
+        sprites.Texture,
+        500,
+        sprites.GetRegion(sprites.FindRegion("particle"))
     );
 
     // Effects
     Effects = new PostProcessor(
-        ResourceManager::GetShader("postprocess"),
+        ResourceManager::GetShader(postprocessShader),
         this->Width,
         this->Height
     );
 }
 
-void Game::ProcessInput(float deltaTime)
+void Game::Start()
 {
-    if (this->State == GAME_ACTIVE)
-    {
-        float velocity = PLAYER_VELOCITY * deltaTime;
-        // move player
-        if (this->Keys[GLFW_KEY_A])
-        {
-            if (Player->Position.x >= 0.0f)
-            {
-                Player->Position.x -= velocity;
+    this->startTime = std::chrono::steady_clock::now();
 
-                if (Ball->Stuck)
-                {
-                    Ball->Position.x -= velocity;
-                }
-            }
-        }
+    // Render has something to draw before the first tick
+    this->snapshots.Back().Capture(this->Sim, this->Clock.Ticks(), 0.0);
+    this->snapshots.Publish();
+    this->particleTick = this->Clock.Ticks();
 
-        if (this->Keys[GLFW_KEY_D])
-        {
-            if (Player->Position.x <= this->Width - Player->Size.x)
-            {
-                Player->Position.x += velocity;
-
-                if (Ball->Stuck)
-                {
-                    Ball->Position.x += velocity;
-                }
-            }
-        }
-
-        if (this->Keys[GLFW_KEY_SPACE])
-        {
-            Ball->Stuck = false;
-        }
-    }
+    this->running = true;
+    this->simThread = std::thread{ &Game::simulate, this };
 }
 
-void Game::Update(float deltaTime)
+void Game::Stop()
 {
-    // Update objects
-    Ball->Move(deltaTime, this->Width);
-
-    // Check for collisions
-    DoCollisions();
-
-    if (Ball->Position.y >= this->Height)
-    {
-        this->ResetLevel();
-        this->ResetPlayer();
-    }
-
-    // Update particles
-    Particles->Update(deltaTime, *Ball, 2, glm::vec2{ Ball->Radius / 2.0f });
-
-    // Update powerups
-    this->UpdatePowerUps(deltaTime);
-
-    if (ShakeTime > 0.0f)
+    if (this->running.exchange(false))
     {
-        ShakeTime -= deltaTime;
-        if (ShakeTime <= 0.0f)
-        {
-            Effects->Shake = false;
-        }
+        this->simThread.join();
     }
 }
 
-void Game::Render()
+double Game::now() const
 {
-    if (this->State == GAME_ACTIVE)
-    {
-        Effects->BeginRender();
-        // Draw background
-        Renderer->DrawSprite(ResourceManager::GetTexture("background"),
-            glm::vec2{ 0.0f, 0.0f }, glm::vec2{ this->Width, this->Height }, 0.0f);
-
-        this->Levels[this->Level].Draw(*Renderer);
-
-        Player->Draw(*Renderer);
-        Particles->Draw();
-        Ball->Draw(*Renderer);
-        Effects->EndRender();
-        Effects->Render(glfwGetTime());
-
-        for (PowerUp& powerUp : this->PowerUps)
-        {
-            if (!powerUp.Destroyed)
-            {
-                powerUp.Draw(*Renderer);
-            }
-        }
-    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
 }
 
-// PowerUps
-void ActivatePowerUp(PowerUp& powerUp)
+void Game::simulate()
 {
-    if (powerUp.Type == "speed")
-    {
-        Ball->Velocity *= 1.2;
-    }
-    else if (powerUp.Type == "sticky")
-    {
-        Ball->Sticky = true;
-        Player->Color = glm::vec3{ 1.0f, 0.5f, 1.0f };
-    }
-    else if (powerUp.Type == "pass-through")
-    {
-        Ball->PassThrough = true;
-        Ball->Color = glm::vec3{ 1.0f, 0.5f, 0.5f };
-    }
-    else if (powerUp.Type == "pad-size-increase")
-    {
-        Player->Size.x += 50;
-    }
-    else if (powerUp.Type == "confuse")
-    {
-        if (!Effects->Chaos)
-        {
-            Effects->Confuse = true;
-        }
-    }
-    else if (powerUp.Type == "chaos")
+    double last = this->now();
+    while (this->running.load(std::memory_order_relaxed))
     {
-        if (!Effects->Confuse)
-        {
-            Effects->Chaos = true;
-        }
-    }
-}
-
-// Collision detection
-bool CheckCollision(GameObject& one, GameObject& two);
-Collision CheckCollision(BallObject& one, GameObject& two);
-Direction VectorDirection(glm::vec2 closest);
+        double current = this->now();
+        unsigned int ticks = this->Clock.Advance(current - last);
+        last = current;
 
-void Game::DoCollisions()
-{
-    for (GameObject& box : this->Levels[this->Level].Bricks)
-    {
-        if (!box.Destroyed)
+        if (ticks > 0)
         {
-            Collision collision = CheckCollision(*Ball, box);
-
-            // If collision is true in the tuple
-            if (std::get<0>(collision))
-            {
-                // Destroy block if not solid
-                if (!box.IsSolid)
-                {
-                    box.Destroyed = true;
-                    this->SpawnPowerUps(box);
-                }
-                else
-                {
-                    ShakeTime = 0.05f;
-                    Effects->Shake = true;
-                }
-
-                // Collision resolution
-                Direction direction = std::get<1>(collision);
-                glm::vec2 differenceVector = std::get<2>(collision);
-
-                if (!(Ball->PassThrough && !box.IsSolid))
-                {
-                    // Horizontal collision
-                    if (direction == LEFT || direction == RIGHT)
-                    {
-                        // Reverse horizontal velocity
-                        Ball->Velocity.x = -Ball->Velocity.x;
-                        // relocate
-                        float penetration = Ball->Radius - std::abs(differenceVector.x);
-                        if (direction == LEFT)
-                        {
-                            Ball->Position.x += penetration;
-                        }
-                        else
-                        {
-                            Ball->Position.x -= penetration;
-                        }
-                    }
-                    else // Vertical collision
-                    {
-                        Ball->Velocity.y = -Ball->Velocity.y; // Reverse vertical velocity
-                        // relocate
-                        float penetration = Ball->Radius - std::abs(differenceVector.y);
-                        if (direction == UP)
-                        {
-                            Ball->Position.y -= penetration; // move ball back up
-                        }
-                        else
-                        {
-                            Ball->Position.y += penetration; // move ball back down
-                        }
-                    }
-                }
-            }
-        }
-    }
+            SimInput input;
+            input.Left = this->Keys[GLFW_KEY_A];
+            input.Right = this->Keys[GLFW_KEY_D];
+            input.Launch = this->Keys[GLFW_KEY_SPACE];
 
-    Collision result = CheckCollision(*Ball, *Player);
-    if (!Ball->Stuck && std::get<0>(result))
-    {
-        // check where it hit the paddle, and change velocity based on where it hit the paddle
-        float centerBoard{ Player->Position.x + Player->Size.x / 2.0f };
-        float distance{ (Ball->Position.x + Ball->Radius) - centerBoard };
-        float percentage{ distance / (Player->Size.x / 2.0f) };
-
-        // then move accordingly
-        float strength{ 2.0f };
-        glm::vec2 oldVelocity{ Ball->Velocity };
-        Ball->Velocity.x = INITIAL_BALL_VELOCITY.x * percentage * strength;
-        Ball->Velocity.y = -1.0f * abs(Ball->Velocity.y);
-        Ball->Velocity = glm::normalize(Ball->Velocity) * glm::length(oldVelocity);
-        Ball->Stuck = Ball->Sticky;
-    }
-
-    for (PowerUp& powerUp : this->PowerUps)
-    {
-        if (!powerUp.Destroyed)
-        {
-            if (powerUp.Position.y >= this->Height)
+            for (; ticks > 0; --ticks)
             {
-                powerUp.Destroyed = true;
+                this->Recorder.Record(input);
+                this->Sim.Step(input, SIM_TICK);
             }
 
-            if (CheckCollision(*Player, powerUp))
-            {
-                ActivatePowerUp(powerUp);
-                powerUp.Destroyed = true;
-                powerUp.Activated = true;
-            }
+            // Stamp the snapshot with the time its last tick ended, not the time it was captured
+            double tickEnd = current - this->Clock.Alpha() * this->Clock.TickLength();
+            this->snapshots.Back().Capture(this->Sim, this->Clock.Ticks(), tickEnd);
+            this->snapshots.Publish();
         }
+
+        // Sleep until the next tick is due
+        std::this_thread::sleep_for(std::chrono::duration<double>((1.0 - this->Clock.Alpha()) * this->Clock.TickLength()));
     }
 }
 
-void Game::ResetLevel()
+// Draws a game object with the given atlas region, at its position 'alpha' of the way through the last tick
+void drawObject(const ObjectSnapshot& object, TextureAtlas& atlas, const AtlasRegion& region, float alpha)
 {
-    if (this->Level == 0)
-        this->Levels[0].Load("assets/levels/one.level", this->Width, this->Height / 2);
-    else if (this->Level == 1)
-        this->Levels[1].Load("assets/levels/two.level", this->Width, this->Height / 2);
-    else if (this->Level == 2)
-        this->Levels[2].Load("assets/levels/three.level", this->Width, this->Height / 2);
-    else if (this->Level == 3)
-        this->Levels[3].Load("assets/levels/four.level", this->Width, this->Height / 2);
+    glm::vec2 position = glm::mix(object.PreviousPosition, object.Position, alpha);
+    Renderer->DrawSprite(atlas.Texture, position, object.Size, object.Rotation, object.Color, region);
 }
 
-void Game::ResetPlayer()
+void Game::Render()
 {
-    Player->Size = PLAYER_SIZE;
-    Player->Position = glm::vec2{ this->Width / 2.0f - PLAYER_SIZE.x / 2.0f, this->Height - PLAYER_SIZE.y };
-    Ball->Reset(Player->Position + glm::vec2{ PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -(BALL_RADIUS * 2.0f) }, INITIAL_BALL_VELOCITY);
-}
+    // The shaders only use time in periodic functions of whole multiples of it; wrapping before narrowing to float
+    // keeps its precision on long runs
+    Frame->Time = static_cast<float>(std::fmod(glfwGetTime(), 2.0 * 3.14159265358979323846));
+    Frame->Upload();
 
-bool ShouldSpawn(unsigned int chance)
-{
-    unsigned int random = rand() % chance;
-    return random == 0;
-}
+    this->snapshots.Acquire();
+    const RenderSnapshot& snapshot = this->snapshots.Front();
 
-void Game::SpawnPowerUps(GameObject& block)
-{
-    if (ShouldSpawn(75)) // 1 in 75
-    {
-        this->PowerUps.push_back(
-            PowerUp("speed", glm::vec3{ 0.5f, 0.5f, 1.0f }, 0.0f, block.Position, ResourceManager::GetTexture("powerup_speed"))
-        );
-    }
+    // Blend by how far real time has moved past the snapshot's tick
+    float alpha = glm::clamp(static_cast<float>((this->now() - snapshot.Time) / this->Clock.TickLength()), 0.0f, 1.0f);
 
-    if (ShouldSpawn(75))
-    {
-        this->PowerUps.push_back(
-            PowerUp("sticky", glm::vec3{ 1.0f, 0.5f, 1.0f }, 20.0f, block.Position, ResourceManager::GetTexture("powerup_sticky"))
-        );
-    }
-
-    if (ShouldSpawn(75))
-    {
-        this->PowerUps.push_back(
-            PowerUp("pass-throught", glm::vec3{ 0.5f, 1.5f, 1.0f }, 10.0f, block.Position, ResourceManager::GetTexture("powerup_passthrough"))
-        );
-    }
-
-    if (ShouldSpawn(75))
-    {
-        this->PowerUps.push_back(
-            PowerUp("pad-size-increase", glm::vec3{ 1.0f, 0.6f, 0.4f }, 0.0f, block.Position, ResourceManager::GetTexture("powerup_increase"))
-        );
-    }
-
-    if (ShouldSpawn(75))
-    {
-        this->PowerUps.push_back(
-            PowerUp("confuse", glm::vec3{ 1.0f, 0.3f, 0.3f }, 15.0f, block.Position, ResourceManager::GetTexture("powerup_confuse"))
-        );
-    }
-
-    if (ShouldSpawn(75))
-    {
-        this->PowerUps.push_back(
-            PowerUp("chaos", glm::vec3{ 0.9f, 0.25f, 0.25f }, 15.0f, block.Position, ResourceManager::GetTexture("powerup_chaos"))
-        );
-    }
-}
-
-bool IsOtherPowerUpActive(std::vector<PowerUp>& powerUps, const std::string& type)
-{
-    for (const PowerUp& powerUp : powerUps)
+    // Particles are presentation only: emit and move them once for every tick simulated since the last frame
+    // The trail follows the first ball
+    if (snapshot.Tick > this->particleTick && !snapshot.Balls.empty())
     {
-        if (powerUp.Activated)
+        unsigned long long ticks = std::min(snapshot.Tick - this->particleTick, static_cast<unsigned long long>(MAX_CATCH_UP_TICKS));
+        const ObjectSnapshot& first = snapshot.Balls.front();
+        GameObject ball{ first.Position, first.Size, first.Color, first.Velocity };
+        for (; ticks > 0; --ticks)
         {
-            if (powerUp.Type == type)
-            {
-                return true;
-            }
+            Particles->Update(SIM_TICK, ball, 2, glm::vec2{ snapshot.BallRadius / 2.0f });
         }
+        this->particleTick = snapshot.Tick;
     }
 
-    return false;
-}
+    // Mirror effect state
+    Effects->Confuse = snapshot.Confuse;
+    Effects->Chaos = snapshot.Chaos;
+    Effects->Shake = snapshot.Shake;
 
-void Game::UpdatePowerUps(float deltaTime)
-{
-    for (PowerUp& powerUp : this->PowerUps)
+    if (snapshot.State == GAME_ACTIVE)
     {
-        powerUp.Position += powerUp.Velocity * deltaTime;
+        Effects->BeginRender();
+        Renderer->Begin();
+        // Draw background
+        Renderer->DrawSprite(ResourceManager::GetTexture(Background),
+            glm::vec2{ 0.0f, 0.0f }, glm::vec2{ this->Width, this->Height }, 0.0f);
 
-        if (powerUp.Activated)
+        // Draw level
+        TextureAtlas& sprites = ResourceManager::GetAtlas(SpriteAtlas);
+        const AtlasRegion& block = sprites.GetRegion(BlockRegion);
+        const AtlasRegion& blockSolid = sprites.GetRegion(BlockSolidRegion);
+        const BrickField& bricks = snapshot.Bricks;
+        for (unsigned int i = 0; i < bricks.Count(); ++i)
         {
-            powerUp.Duration -= deltaTime;
-
-            if (powerUp.Duration <= 0.0f)
+            if (!bricks.IsDestroyed(i))
             {
-                // remove powerup from list (will later be removed
-                powerUp.Activated = false;
-                // deactivate effects
-                if (powerUp.Type == "sticky")
-                {
-                    if (!IsOtherPowerUpActive(this->PowerUps, "sticky"))
-                    {
-                        Ball->Sticky = false;
-                        Player->Color = glm::vec3{ 1.0f };
-                    }
-                }
-                else if (powerUp.Type == "pass-through")
-                {
-                    if (!IsOtherPowerUpActive(this->PowerUps, "pass-through"))
-                    {
-                        Ball->PassThrough = false;
-                        Ball->Color = glm::vec3{ 1.0f };
-                    }
-                }
-                else if (powerUp.Type == "confuse")
-                {
-                    if (!IsOtherPowerUpActive(this->PowerUps, "confuse"))
-                    {
-                        Effects->Confuse = false;
-                    }
-                }
-                else if (powerUp.Type == "chaos")
-                {
-                    if (!IsOtherPowerUpActive(this->PowerUps, "chaos"))
-                    {
-                        Effects->Chaos = false;
-                    }
-                }
+                Renderer->DrawSprite(sprites.Texture, bricks.Positions[i], bricks.Sizes[i],
+                    0.0f, BRICK_COLORS[bricks.ColorIndices[i]], bricks.IsSolid(i) ? blockSolid : block);
             }
         }
-    }
-
-    this->PowerUps.erase(std::remove_if(this->PowerUps.begin(), this->PowerUps.end(), [](const PowerUp& powerUp) {return powerUp.Destroyed && !powerUp.Activated; }), this->PowerUps.end());
-}
-
-bool CheckCollision(GameObject& one, GameObject& two) // AABB - AABB collision
-{
-    // collision x-axis?
-    bool collisionX = one.Position.x + one.Size.x >= two.Position.x &&
-        two.Position.x + two.Size.x >= one.Position.x;
-    // collision y-axis?
-    bool collisionY = one.Position.y + one.Size.y >= two.Position.y &&
-        two.Position.y + two.Size.y >= one.Position.y;
-    // collision only if on both axes
-    return collisionX && collisionY;
-}
-
-Collision CheckCollision(BallObject& ball, GameObject& other)
-{
-    // Get center point of the circle first
-    glm::vec2 center{ ball.Position + ball.Radius };
 
-    // Calculate AABB info
-    glm::vec2 aabbHalfExtents{ other.Size.x / 2.0f, other.Size.y / 2.0f };
-    glm::vec2 aabbCenter{ other.Position.x + aabbHalfExtents.x, other.Position.y + aabbHalfExtents.y };
-
-    // Get the difference vector between both centers
-    glm::vec2 difference{ center - aabbCenter };
-    glm::vec2 clamped{ glm::clamp(difference, -aabbHalfExtents, aabbHalfExtents) };
-
-    // Add clamped value to AABCenter and we get the value of box closest to circle
-    glm::vec2 closest{ aabbCenter + clamped };
-
-    // Retrieve vector between center circle and closest point AABB and check if lenght <= radius
-    difference = closest - center;
-
-    if (glm::length(difference) <= ball.Radius)
-    {
-        return std::make_tuple(true, VectorDirection(difference), difference);
-    }
-    else
-    {
-        return std::make_tuple(false, UP, glm::vec2{ 0.0f, 0.0f });
-    }
-}
+        drawObject(snapshot.Player, sprites, sprites.GetRegion(PaddleRegion), alpha);
+        Renderer->End();
+        Particles->Draw();
+        Renderer->Begin();
+        const AtlasRegion& face = sprites.GetRegion(FaceRegion);
+        for (const ObjectSnapshot& ball : snapshot.Balls)
+        {
+            drawObject(ball, sprites, face, alpha);
+        }
+        Renderer->End();
+        Effects->EndRender();
+        Effects->Render();
 
-// calculates which direction a vector is facing (N,E,S or W)
-Direction VectorDirection(glm::vec2 target)
-{
-    glm::vec2 compass[] = {
-        glm::vec2(0.0f, 1.0f),	// up
-        glm::vec2(1.0f, 0.0f),	// right
-        glm::vec2(0.0f, -1.0f),	// down
-        glm::vec2(-1.0f, 0.0f)	// left
-    };
-    float max = 0.0f;
-    unsigned int best_match = -1;
-    for (unsigned int i = 0; i < 4; i++)
-    {
-        float dot_product = glm::dot(glm::normalize(target), compass[i]);
-        if (dot_product > max)
+        Renderer->Begin();
+        for (const PowerUpSnapshot& powerUp : snapshot.PowerUps)
         {
-            max = dot_product;
-            best_match = i;
+            TextureAtlas& powerUps = ResourceManager::GetAtlas(PowerUpAtlas);
+            drawObject(powerUp.Object, powerUps, powerUps.GetRegion(PowerUpRegions[powerUp.Type]), alpha);
         }
+        Renderer->End();
     }
-    return (Direction)best_match;
-}
\ No newline at end of file
+}
@@ -1,121 +1,220 @@
 #include "Core/GameLevel.h"
 
+#include "Core/MappedFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <string>
 #include <fstream>
+#include <iostream>
 #include <sstream>
-#include <Core/ResourceManager.h>
 
-void GameLevel::Load(const char* file, unsigned int levelWidth, unsigned int levelHeight)
+bool GameLevel::Load(const char* file, unsigned int levelWidth, unsigned int levelHeight)
 {
     // Clear old data
-    this->Bricks.clear();
+    this->Bricks.Clear();
+    this->grid.clear();
 
-    // Load from file
-    unsigned int tileCode;
-    GameLevel level;
-    std::string line;
-    std::ifstream fstream(file);
-    std::vector<std::vector<unsigned int>> tileData;
-    if (fstream)
+    std::string path{ file };
+    const std::string binaryExtension{ ".blevel" };
+    if (path.size() > binaryExtension.size() && path.compare(path.size() - binaryExtension.size(), binaryExtension.size(), binaryExtension) == 0)
     {
-        // Read each line from level file
-        while (std::getline(fstream, line))
+        if (this->loadBinary(file, levelWidth, levelHeight))
         {
-            std::istringstream sstream(line);
-            std::vector<unsigned int> row;
+            return true;
+        }
 
-            // Read each word separated by spaces
-            while (sstream >> tileCode)
-            {
-                row.push_back(tileCode);
-            }
+        // Fall back to the text source
+        path.replace(path.size() - binaryExtension.size(), binaryExtension.size(), ".level");
+        std::cout << "ERROR::LEVEL: Failed to load " << file << ", parsing " << path << " instead" << std::endl;
+    }
 
-            tileData.push_back(row);
-        }
+    std::vector<unsigned char> tiles;
+    unsigned int width, height;
+    if (!parseText(path.c_str(), tiles, width, height))
+    {
+        std::cout << "ERROR::LEVEL: Failed to load " << path << std::endl;
+        return false;
+    }
 
-        if (tileData.size() > 0)
-        {
-            this->init(tileData, levelWidth, levelHeight);
-        }
+    this->init(tiles.data(), width, height, levelWidth, levelHeight);
+    return true;
+}
+
+bool GameLevel::Compile(const char* source, const char* target)
+{
+    std::vector<unsigned char> tiles;
+    unsigned int width, height;
+    if (!parseText(source, tiles, width, height))
+    {
+        std::cout << "ERROR::LEVEL: Failed to read " << source << std::endl;
+        return false;
     }
+
+    LevelFileHeader header{ { 'B', 'L', 'V', 'L' }, LEVEL_FILE_VERSION, width, height };
+    std::ofstream fstream(target, std::ios::binary);
+    fstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fstream.write(reinterpret_cast<const char*>(tiles.data()), tiles.size());
+    if (!fstream)
+    {
+        std::cout << "ERROR::LEVEL: Failed to write " << target << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void GameLevel::Reset()
+{
+    this->Bricks.Restore();
+}
+
+bool GameLevel::IsCompleted() const
+{
+    return this->IsPlayable() && this->Bricks.AllCleared();
 }
 
-void GameLevel::Draw(SpriteRenderer& renderer)
+void GameLevel::QueryBricks(glm::vec2 min, glm::vec2 max, std::vector<unsigned int>& result) const
 {
-    for (GameObject& tile : this->Bricks)
+    result.clear();
+
+    // Early out when the region lies completely outside the brick area
+    if (this->grid.empty() || max.x < 0.0f || max.y < 0.0f ||
+        min.x > this->gridWidth * this->unitWidth || min.y > this->gridHeight * this->unitHeight)
     {
-        if (!tile.Destroyed)
+        return;
+    }
+
+    // Clamp the region to the grid
+    int firstX = std::max(0, static_cast<int>(std::floor(min.x / this->unitWidth)));
+    int firstY = std::max(0, static_cast<int>(std::floor(min.y / this->unitHeight)));
+    int lastX = std::min(static_cast<int>(this->gridWidth) - 1, static_cast<int>(std::floor(max.x / this->unitWidth)));
+    int lastY = std::min(static_cast<int>(this->gridHeight) - 1, static_cast<int>(std::floor(max.y / this->unitHeight)));
+
+    for (int y = firstY; y <= lastY; ++y)
+    {
+        for (int x = firstX; x <= lastX; ++x)
         {
-            tile.Draw(renderer);
+            int index = this->grid[y * this->gridWidth + x];
+            if (index >= 0 && !this->Bricks.IsDestroyed(index))
+            {
+                result.push_back(index);
+            }
         }
     }
 }
 
-bool GameLevel::IsCompleted()
+bool GameLevel::loadBinary(const char* file, unsigned int levelWidth, unsigned int levelHeight)
 {
-    for (GameObject& tile : this->Bricks)
+    MappedFile mapped;
+    if (!mapped.Open(file) || mapped.Size() < sizeof(LevelFileHeader))
     {
-        if (!tile.IsSolid && !tile.Destroyed)
+        return false;
+    }
+
+    // Validate the header and that the tiles are all there
+    LevelFileHeader header;
+    std::memcpy(&header, mapped.Data(), sizeof(header));
+    if (std::memcmp(header.Magic, "BLVL", 4) != 0 || header.Version != LEVEL_FILE_VERSION || header.Width == 0 || header.Height == 0 ||
+        mapped.Size() != sizeof(header) + static_cast<std::size_t>(header.Width) * header.Height)
+    {
+        return false;
+    }
+
+    this->init(mapped.Data() + sizeof(header), header.Width, header.Height, levelWidth, levelHeight);
+    return true;
+}
+
+bool GameLevel::parseText(const char* file, std::vector<unsigned char>& tiles, unsigned int& width, unsigned int& height)
+{
+    std::ifstream fstream(file);
+    if (!fstream)
+    {
+        return false;
+    }
+
+    // Read each line from level file; the first row fixes the width, blank lines are skipped
+    unsigned int tileCode;
+    std::string line;
+    width = 0;
+    height = 0;
+    tiles.clear();
+    while (std::getline(fstream, line))
+    {
+        std::istringstream sstream(line);
+        unsigned int count = 0;
+
+        // Read each word separated by spaces; codes above 255 are white bricks just like 6 to 255
+        while (sstream >> tileCode)
+        {
+            if (height == 0 || count < width)
+            {
+                tiles.push_back(static_cast<unsigned char>(std::min(tileCode, 255u)));
+            }
+            ++count;
+        }
+
+        if (count == 0)
         {
-            return false;
+            continue;
         }
+
+        if (height == 0)
+        {
+            width = count;
+        }
+        else if (count < width)
+        {
+            tiles.resize(tiles.size() + width - count, 0);
+        }
+        ++height;
     }
 
-    return true;
+    return height > 0;
 }
 
-void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned int levelWidth, unsigned int levelHeight)
+void GameLevel::init(const unsigned char* tiles, unsigned int width, unsigned int height, unsigned int levelWidth, unsigned int levelHeight)
 {
     // Calculate dimensions
-    unsigned int height = tileData.size();
-    unsigned int width = tileData[0].size();
     float unitWidth = levelWidth / static_cast<float>(width);
     float unitHeight = levelHeight / height;
 
+    // Keep the tile layout for the broadphase
+    this->gridWidth = width;
+    this->gridHeight = height;
+    this->unitWidth = unitWidth;
+    this->unitHeight = unitHeight;
+    this->grid.assign(width * height, -1);
+
+    // Size the brick storage up front
+    unsigned int brickCount = 0;
+    for (unsigned int i = 0; i < width * height; ++i)
+    {
+        brickCount += tiles[i] != 0;
+    }
+    this->Bricks.Reserve(brickCount);
+
     // Initialize level tiles based on tileData
     for (unsigned int y = 0; y < height; ++y)
     {
         for (unsigned int x = 0; x < width; ++x)
         {
             // Check block type from level data (2D level array)
-            if (tileData[y][x] == 1) // Solid
+            unsigned int tileCode = tiles[y * width + x];
+            if (tileCode == 0)
             {
-                glm::vec2 pos{ unitWidth * x, unitHeight * y };
-                glm::vec2 size{ unitWidth, unitHeight };
+                continue;
+            }
 
-                GameObject obj{ pos, size, ResourceManager::GetTexture("block_solid"),
-                glm::vec3{0.8f, 0.8f, 0.7f} };
+            glm::vec2 pos{ unitWidth * x, unitHeight * y };
+            glm::vec2 size{ unitWidth, unitHeight };
 
-                obj.IsSolid = true;
-                
-                this->Bricks.push_back(obj);
-            }
-            else if (tileData[y][x] > 1)
-            {
-                glm::vec3 color{ glm::vec3{1.0f} }; // Original: white
-
-                if (tileData[y][x] == 2)
-                {
-                    color = glm::vec3{ 0.2f, 0.6f, 1.0f };
-                }
-                else if (tileData[y][x] == 3)
-                {
-                    color = glm::vec3{ 0.0f, 0.7f, 0.0f };
-                }
-                else if (tileData[y][x] == 4)
-                {
-                    color = glm::vec3{ 0.8f, 0.8f, 0.4f };
-                }
-                else if (tileData[y][x] == 5)
-                {
-                    color = glm::vec3{ 1.0f, 0.5f, 0.0f };
-                }
-
-                glm::vec2 pos{ unitWidth * x, unitHeight * y };
-                glm::vec2 size{ unitWidth, unitHeight };
-
-                this->Bricks.push_back(GameObject{ pos, size, ResourceManager::GetTexture("block"), color });
-            }
+            // 1 is solid, 2 to 5 pick a color, anything above stays white
+            bool solid = tileCode == 1;
+            unsigned char colorIndex = tileCode <= 5 ? static_cast<unsigned char>(tileCode) : 0;
+
+            this->grid[y * width + x] = static_cast<int>(this->Bricks.Add(pos, size, solid, colorIndex));
         }
     }
 }
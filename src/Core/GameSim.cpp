@@ -0,0 +1,549 @@
+#include "Core/GameSim.h"
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+// Level files in play order
+const char* const LEVEL_FILES[]{
+    "assets/levels/one.blevel",
+    "assets/levels/two.blevel",
+    "assets/levels/three.blevel",
+    "assets/levels/four.blevel"
+};
+
+// Candidates per job when a sweep is split up; smaller batches are swept on the calling thread
+const unsigned int COLLISION_GRAIN{ 1024 };
+// Most contacts resolved for one ball in one step; motion left after that is dropped
+const unsigned int MAX_BOUNCES{ 8 };
+// Power-ups integrated per job
+const unsigned int POWERUP_GRAIN{ 4096 };
+// Balls moved and collided per job
+const unsigned int BALL_GRAIN{ 64 };
+// Angle between the balls SplitBalls fans out, in radians
+const float SPLIT_ANGLE{ 0.3f };
+
+// Earliest hit of a swept ball among the candidates, or boxes.Count(). Large batches are swept in chunks on the job
+// system; the earliest hit wins, the lower index on ties, so the result matches a serial sweep.
+static unsigned int earliestHit(glm::vec2 center, float radius, glm::vec2 motion, const BoxBatch& boxes, SweepHit& hit)
+{
+    unsigned int count = boxes.Count();
+    if (count <= COLLISION_GRAIN || JobSystem::WorkerCount() == 0)
+    {
+        return SweepCircle(center, radius, motion, boxes, 0, count, hit);
+    }
+
+    unsigned int chunks = (count + COLLISION_GRAIN - 1) / COLLISION_GRAIN;
+    std::vector<unsigned int> indices(chunks);
+    std::vector<SweepHit> hits(chunks);
+    JobSystem::ParallelFor(count, COLLISION_GRAIN, [&](unsigned int first, unsigned int last) {
+        unsigned int chunk = first / COLLISION_GRAIN;
+        indices[chunk] = SweepCircle(center, radius, motion, boxes, first, last, hits[chunk]);
+    });
+
+    // Merge in candidate order
+    unsigned int best = count;
+    for (unsigned int chunk = 0; chunk < chunks; ++chunk)
+    {
+        unsigned int last = std::min((chunk + 1) * COLLISION_GRAIN, count);
+        if (indices[chunk] < last && (best == count || hits[chunk].Time < hit.Time))
+        {
+            best = indices[chunk];
+            hit = hits[chunk];
+        }
+    }
+
+    return best;
+}
+
+// Earliest contact of a swept ball with the left, right and top screen edges; the bottom is open
+static bool sweepWalls(glm::vec2 center, float radius, glm::vec2 motion, float width, SweepHit& hit)
+{
+    bool found = false;
+    auto consider = [&](float time, glm::vec2 normal) {
+        time = std::max(time, 0.0f);
+        if (!found || time < hit.Time)
+        {
+            hit = SweepHit{ time, normal };
+            found = true;
+        }
+    };
+
+    if (motion.x < 0.0f && center.x + motion.x <= radius)
+    {
+        consider((radius - center.x) / motion.x, glm::vec2{ 1.0f, 0.0f });
+    }
+    else if (motion.x > 0.0f && center.x + motion.x >= width - radius)
+    {
+        consider((width - radius - center.x) / motion.x, glm::vec2{ -1.0f, 0.0f });
+    }
+
+    if (motion.y < 0.0f && center.y + motion.y <= radius)
+    {
+        consider((radius - center.y) / motion.y, glm::vec2{ 0.0f, 1.0f });
+    }
+
+    return found;
+}
+
+GameSim::GameSim(unsigned int width, unsigned int height)
+    : State(GameState::GAME_ACTIVE), Width(width), Height(height), Levels(width, height / 2)
+{
+}
+
+void GameSim::Init(std::uint32_t seed)
+{
+    this->Seed = seed;
+    this->random.seed(seed);
+
+    // Load the first level; the next one is prefetched in the background
+    this->Levels.Start(std::vector<std::string>(std::begin(LEVEL_FILES), std::end(LEVEL_FILES)), 0);
+
+    // Player
+    glm::vec2 playerPosition{ glm::vec2{
+        this->Width / 2.0f - PLAYER_SIZE.x / 2.0f,
+        this->Height - PLAYER_SIZE.y} };
+    this->Player = GameObject{ playerPosition, PLAYER_SIZE };
+
+    // Ball
+    glm::vec2 ballPosition{ playerPosition + glm::vec2{PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -BALL_RADIUS * 2.0f} };
+    this->Balls.assign(1, BallObject{ ballPosition, BALL_RADIUS, INITIAL_BALL_VELOCITY });
+}
+
+void GameSim::Step(const SimInput& input, float deltaTime)
+{
+    // Remember where everything moving was before this tick
+    this->Player.PreviousPosition = this->Player.Position;
+    for (BallObject& ball : this->Balls)
+    {
+        ball.PreviousPosition = ball.Position;
+    }
+    for (PowerUp& powerUp : this->PowerUps)
+    {
+        powerUp.PreviousPosition = powerUp.Position;
+    }
+
+    this->ProcessInput(input, deltaTime);
+    this->Update(deltaTime);
+}
+
+void GameSim::ProcessInput(const SimInput& input, float deltaTime)
+{
+    if (this->State == GAME_ACTIVE)
+    {
+        float velocity = PLAYER_VELOCITY * deltaTime;
+        // move player
+        if (input.Left)
+        {
+            if (this->Player.Position.x >= 0.0f)
+            {
+                this->Player.Position.x -= velocity;
+
+                for (BallObject& ball : this->Balls)
+                {
+                    if (ball.Stuck)
+                    {
+                        ball.Position.x -= velocity;
+                    }
+                }
+            }
+        }
+
+        if (input.Right)
+        {
+            if (this->Player.Position.x <= this->Width - this->Player.Size.x)
+            {
+                this->Player.Position.x += velocity;
+
+                for (BallObject& ball : this->Balls)
+                {
+                    if (ball.Stuck)
+                    {
+                        ball.Position.x += velocity;
+                    }
+                }
+            }
+        }
+
+        if (input.Launch)
+        {
+            for (BallObject& ball : this->Balls)
+            {
+                ball.Stuck = false;
+            }
+        }
+    }
+}
+
+void GameSim::Update(float deltaTime)
+{
+    this->Time += deltaTime;
+
+    // Move the balls, colliding along the way
+    this->DoCollisions(deltaTime);
+
+    // Move on once every destructible brick is gone
+    if (this->Levels.Current().IsCompleted())
+    {
+        this->NextLevel();
+    }
+
+    // Drop the balls that fell out; losing the last one restarts the level
+    this->Balls.erase(std::remove_if(this->Balls.begin(), this->Balls.end(), [this](const BallObject& ball) { return ball.Position.y >= this->Height; }), this->Balls.end());
+    if (this->Balls.empty())
+    {
+        this->ResetLevel();
+        this->ResetPlayer();
+    }
+
+    // Update powerups
+    this->UpdatePowerUps(deltaTime);
+
+    if (this->ShakeTime > 0.0f)
+    {
+        this->ShakeTime -= deltaTime;
+        if (this->ShakeTime <= 0.0f)
+        {
+            this->Shake = false;
+        }
+    }
+}
+
+// PowerUps
+void GameSim::ActivatePowerUp(PowerUpType type)
+{
+    const PowerUpKind& kind = POWER_UP_KINDS[type];
+    kind.Activate(*this);
+
+    // Timed effects run until the last power-up of their kind expires
+    if (kind.Duration > 0.0f)
+    {
+        ++this->activeEffects[type];
+        this->effectTimers.push(PowerUpTimer{ this->Time + kind.Duration, type });
+    }
+}
+
+void GameSim::DoCollisions(float deltaTime)
+{
+    // Balls only read the bricks while colliding, so ranges of them run in parallel
+    unsigned int ballCount = static_cast<unsigned int>(this->Balls.size());
+    unsigned int chunkCount = (ballCount + BALL_GRAIN - 1) / BALL_GRAIN;
+    if (this->collisionChunks.size() < chunkCount)
+    {
+        this->collisionChunks.resize(chunkCount);
+    }
+
+    JobSystem::ParallelFor(ballCount, BALL_GRAIN, [this, deltaTime](unsigned int first, unsigned int last) {
+        CollisionChunk& chunk = this->collisionChunks[first / BALL_GRAIN];
+        chunk.HitBricks.clear();
+        chunk.HitSolid = false;
+        for (unsigned int i = first; i < last; ++i)
+        {
+            this->collideBall(this->Balls[i], chunk, deltaTime);
+        }
+    });
+
+    // Apply the hits in ball order. A brick hit by several balls in one tick bounces all of them, but is destroyed and
+    // rolls for power-ups only once, for the first ball.
+    BrickField& bricks = this->Levels.Current().Bricks;
+    for (unsigned int i = 0; i < chunkCount; ++i)
+    {
+        const CollisionChunk& chunk = this->collisionChunks[i];
+        for (unsigned int index : chunk.HitBricks)
+        {
+            if (!bricks.IsDestroyed(index))
+            {
+                bricks.Destroy(index);
+                this->SpawnPowerUps(bricks.Positions[index]);
+            }
+        }
+
+        if (chunk.HitSolid)
+        {
+            this->ShakeTime = 0.05f;
+            this->Shake = true;
+        }
+    }
+
+    GameObject& player = this->Player;
+    for (PowerUp& powerUp : this->PowerUps)
+    {
+        if (!powerUp.Destroyed)
+        {
+            if (powerUp.Position.y >= this->Height)
+            {
+                powerUp.Destroyed = true;
+            }
+
+            if (CheckCollision(player, powerUp))
+            {
+                this->ActivatePowerUp(powerUp.Type);
+                powerUp.Destroyed = true;
+            }
+        }
+    }
+}
+
+void GameSim::collideBall(BallObject& ball, CollisionChunk& chunk, float deltaTime)
+{
+    if (ball.Stuck)
+    {
+        return;
+    }
+
+    const GameLevel& level = this->Levels.Current();
+    const BrickField& bricks = level.Bricks;
+    const GameObject& player = this->Player;
+    // Bricks this ball already hit this step are gone as far as it is concerned
+    size_t ownHits = chunk.HitBricks.size();
+    auto hitBefore = [&chunk, ownHits](unsigned int index) {
+        return std::find(chunk.HitBricks.begin() + ownHits, chunk.HitBricks.end(), index) != chunk.HitBricks.end();
+    };
+
+    // Sweep the ball along its path, stopping at each contact to respond and carry on with the rest of the motion
+    float remaining = 1.0f;
+    for (unsigned int bounce = 0; bounce < MAX_BOUNCES && remaining > 0.0f; ++bounce)
+    {
+        glm::vec2 center{ ball.Position + ball.Radius };
+        glm::vec2 motion{ ball.Velocity * (deltaTime * remaining) };
+
+        // Broadphase: the bricks in the grid cells the swept ball passes
+        level.QueryBricks(glm::min(center, center + motion) - ball.Radius, glm::max(center, center + motion) + ball.Radius, chunk.NearbyBricks);
+
+        // Narrowphase over the bricks that stop the ball; with pass-through only solid ones do
+        chunk.BlockingBricks.clear();
+        chunk.Candidates.Clear();
+        for (unsigned int index : chunk.NearbyBricks)
+        {
+            if ((!ball.PassThrough || bricks.IsSolid(index)) && !hitBefore(index))
+            {
+                chunk.BlockingBricks.push_back(index);
+                chunk.Candidates.Add(bricks.Positions[index], bricks.Sizes[index]);
+            }
+        }
+
+        // Earliest of brick, wall and paddle contacts
+        enum { NOTHING, BRICK, WALL, PADDLE } contact = NOTHING;
+        SweepHit hit{ 1.0f, glm::vec2{ 0.0f } };
+        SweepHit other;
+        unsigned int candidate = earliestHit(center, ball.Radius, motion, chunk.Candidates, other);
+        if (candidate < chunk.Candidates.Count())
+        {
+            contact = BRICK;
+            hit = other;
+        }
+        if (sweepWalls(center, ball.Radius, motion, static_cast<float>(this->Width), other) && (contact == NOTHING || other.Time < hit.Time))
+        {
+            contact = WALL;
+            hit = other;
+        }
+        if (SweepCircle(center, ball.Radius, motion, player.Position, player.Size, other) && (contact == NOTHING || other.Time < hit.Time))
+        {
+            contact = PADDLE;
+            hit = other;
+        }
+
+        // A pass-through ball breaks every brick it passes on the way
+        if (ball.PassThrough)
+        {
+            for (unsigned int index : chunk.NearbyBricks)
+            {
+                if (!bricks.IsSolid(index) && !hitBefore(index) &&
+                    SweepCircle(center, ball.Radius, motion, bricks.Positions[index], bricks.Sizes[index], other) && other.Time <= hit.Time)
+                {
+                    chunk.HitBricks.push_back(index);
+                }
+            }
+        }
+
+        ball.Position += motion * hit.Time;
+        remaining *= 1.0f - hit.Time;
+
+        if (contact == NOTHING)
+        {
+            break;
+        }
+        else if (contact == PADDLE)
+        {
+            // check where it hit the paddle, and change velocity based on where it hit the paddle
+            float centerBoard{ player.Position.x + player.Size.x / 2.0f };
+            float distance{ (ball.Position.x + ball.Radius) - centerBoard };
+            float percentage{ distance / (player.Size.x / 2.0f) };
+
+            // then move accordingly
+            float strength{ 2.0f };
+            glm::vec2 oldVelocity{ ball.Velocity };
+            ball.Velocity.x = INITIAL_BALL_VELOCITY.x * percentage * strength;
+            ball.Velocity.y = -1.0f * std::abs(ball.Velocity.y);
+            ball.Velocity = glm::normalize(ball.Velocity) * glm::length(oldVelocity);
+            ball.Stuck = ball.Sticky;
+            if (ball.Stuck)
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (contact == BRICK)
+            {
+                // Destroy block if not solid; applied once all balls are done
+                unsigned int index = chunk.BlockingBricks[candidate];
+                if (!bricks.IsSolid(index))
+                {
+                    chunk.HitBricks.push_back(index);
+                }
+                else
+                {
+                    chunk.HitSolid = true;
+                }
+            }
+
+            // Bounce off the surface
+            ball.Velocity -= 2.0f * glm::dot(ball.Velocity, hit.Normal) * hit.Normal;
+        }
+    }
+}
+
+void GameSim::ResetLevel()
+{
+    this->Levels.Current().Reset();
+}
+
+void GameSim::NextLevel()
+{
+    // The streamed-in level is freshly loaded; wraps around after the last level
+    this->Levels.Advance();
+    this->ResetPlayer();
+
+    // Power-ups and their effects do not carry over
+    this->ClearPowerUps();
+}
+
+void GameSim::ResetPlayer()
+{
+    this->Player.Size = PLAYER_SIZE;
+    this->Player.Position = glm::vec2{ this->Width / 2.0f - PLAYER_SIZE.x / 2.0f, this->Height - PLAYER_SIZE.y };
+    this->Balls.resize(1, BallObject{ glm::vec2{ 0.0f }, BALL_RADIUS, INITIAL_BALL_VELOCITY });
+    BallObject& ball = this->Balls.front();
+    ball.Reset(this->Player.Position + glm::vec2{ PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -(BALL_RADIUS * 2.0f) }, INITIAL_BALL_VELOCITY);
+
+    // Teleports are not interpolated
+    this->Player.PreviousPosition = this->Player.Position;
+    ball.PreviousPosition = ball.Position;
+}
+
+void GameSim::SplitBalls()
+{
+    // Each ball keeps its direction and gets a copy on either side of it, in flight even if the original is stuck
+    unsigned int count = static_cast<unsigned int>(this->Balls.size());
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        for (float angle : { -SPLIT_ANGLE, SPLIT_ANGLE })
+        {
+            if (this->Balls.size() >= MAX_BALLS)
+            {
+                return;
+            }
+
+            BallObject copy = this->Balls[i];
+            float cos = std::cos(angle), sin = std::sin(angle);
+            copy.Velocity = glm::vec2{ cos * copy.Velocity.x - sin * copy.Velocity.y, sin * copy.Velocity.x + cos * copy.Velocity.y };
+            copy.Stuck = false;
+            this->Balls.push_back(copy);
+        }
+    }
+}
+
+bool GameSim::shouldSpawn(unsigned int chance)
+{
+    unsigned int random = this->random() % chance;
+    return random == 0;
+}
+
+void GameSim::SpawnPowerUps(glm::vec2 position)
+{
+    for (unsigned int type = 0; type < POWERUP_TYPE_COUNT; ++type)
+    {
+        if (this->shouldSpawn(POWER_UP_KINDS[type].SpawnChance))
+        {
+            this->PowerUps.push_back(PowerUp(static_cast<PowerUpType>(type), position));
+        }
+    }
+}
+
+void GameSim::UpdatePowerUps(float deltaTime)
+{
+    JobSystem::ParallelFor(static_cast<unsigned int>(this->PowerUps.size()), POWERUP_GRAIN, [this, deltaTime](unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; ++i)
+        {
+            this->PowerUps[i].Position += this->PowerUps[i].Velocity * deltaTime;
+        }
+    });
+
+    // Expire timed effects, deactivating a kind once none of it is left
+    while (!this->effectTimers.empty() && this->effectTimers.top().Expires <= this->Time)
+    {
+        PowerUpType type = this->effectTimers.top().Type;
+        this->effectTimers.pop();
+
+        if (--this->activeEffects[type] == 0)
+        {
+            POWER_UP_KINDS[type].Deactivate(*this);
+        }
+    }
+
+    this->PowerUps.erase(std::remove_if(this->PowerUps.begin(), this->PowerUps.end(), [](const PowerUp& powerUp) {return powerUp.Destroyed; }), this->PowerUps.end());
+}
+
+void GameSim::ClearPowerUps()
+{
+    this->PowerUps.clear();
+
+    for (unsigned int type = 0; type < POWERUP_TYPE_COUNT; ++type)
+    {
+        if (this->activeEffects[type] > 0)
+        {
+            POWER_UP_KINDS[type].Deactivate(*this);
+            this->activeEffects[type] = 0;
+        }
+    }
+    this->effectTimers = {};
+}
+
+std::uint64_t GameSim::Hash(std::uint64_t hash) const
+{
+    // Field by field, so padding never ends up in the hash
+    auto add = [&hash](const auto& value) { hash = HashBytes(&value, sizeof(value), hash); };
+
+    add(this->State);
+    add(this->Time);
+    add(this->Levels.CurrentIndex());
+    hash = this->Levels.Current().Bricks.Hash(hash);
+
+    add(this->Player.Position);
+    add(this->Player.Size);
+    for (const BallObject& ball : this->Balls)
+    {
+        add(ball.Position);
+        add(ball.Velocity);
+        add(ball.Color);
+        add(ball.Stuck);
+        add(ball.Sticky);
+        add(ball.PassThrough);
+    }
+    for (const PowerUp& powerUp : this->PowerUps)
+    {
+        add(powerUp.Type);
+        add(powerUp.Position);
+        add(powerUp.Destroyed);
+    }
+
+    add(this->activeEffects);
+    add(this->Confuse);
+    add(this->Chaos);
+    add(this->Shake);
+    add(this->ShakeTime);
+    return hash;
+}
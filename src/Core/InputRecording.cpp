@@ -0,0 +1,240 @@
+#include "Core/InputRecording.h"
+
+#include <cstring>
+#include <iostream>
+
+// Encoded bytes collected before they are handed to the writer thread
+const std::size_t RECORDING_BLOCK_SIZE{ 4096 };
+
+// One bit per SimInput field
+static unsigned char encodeInput(const SimInput& input)
+{
+    return (input.Left ? 1 : 0) | (input.Right ? 2 : 0) | (input.Launch ? 4 : 0);
+}
+
+static SimInput decodeInput(unsigned char bits)
+{
+    SimInput input;
+    input.Left = (bits & 1) != 0;
+    input.Right = (bits & 2) != 0;
+    input.Launch = (bits & 4) != 0;
+    return input;
+}
+
+InputRecorder::~InputRecorder()
+{
+    this->Close();
+}
+
+bool InputRecorder::Open(const char* file, const GameSim& sim, float tickLength)
+{
+    this->Close();
+
+    this->stream.open(file, std::ios::binary);
+    if (!this->stream)
+    {
+        std::cout << "ERROR::RECORDING: Failed to create " << file << std::endl;
+        return false;
+    }
+
+    RecordingFileHeader header{ { 'B', 'R', 'E', 'C' }, RECORDING_FILE_VERSION, sim.Seed, sim.Width, sim.Height, tickLength };
+    this->stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    this->buffer.clear();
+    this->lastInput = 0;
+    this->tick = 0;
+    this->lastEventTick = 0;
+    this->closing = false;
+    this->writer = std::thread{ &InputRecorder::writeLoop, this };
+    return true;
+}
+
+void InputRecorder::Close()
+{
+    if (!this->IsOpen())
+    {
+        return;
+    }
+
+    // The end marker holds the ticks since the last change, so the replay runs exactly as long as the recording
+    this->writeEvent(END_OF_INPUT);
+    this->flush();
+
+    {
+        std::lock_guard<std::mutex> guard{ this->lock };
+        this->closing = true;
+    }
+    this->wake.notify_one();
+    this->writer.join();
+
+    this->stream.close();
+    if (this->stream.fail())
+    {
+        std::cout << "ERROR::RECORDING: Failed to write the recording" << std::endl;
+    }
+}
+
+void InputRecorder::Record(const SimInput& input)
+{
+    if (!this->IsOpen())
+    {
+        return;
+    }
+
+    // Only changes are written
+    unsigned char bits = encodeInput(input);
+    if (bits != this->lastInput)
+    {
+        this->writeEvent(bits);
+    }
+    ++this->tick;
+
+    if (this->buffer.size() >= RECORDING_BLOCK_SIZE)
+    {
+        this->flush();
+    }
+}
+
+void InputRecorder::writeEvent(unsigned char bits)
+{
+    // Ticks since the previous event, seven bits at a time, then the new input
+    unsigned long long delta = this->tick - this->lastEventTick;
+    do
+    {
+        unsigned char byte = delta & 0x7F;
+        delta >>= 7;
+        this->buffer.push_back(delta != 0 ? byte | 0x80 : byte);
+    } while (delta != 0);
+    this->buffer.push_back(bits);
+
+    this->lastInput = bits;
+    this->lastEventTick = this->tick;
+}
+
+void InputRecorder::flush()
+{
+    if (this->buffer.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{ this->lock };
+        this->pending.push_back(std::move(this->buffer));
+    }
+    this->wake.notify_one();
+
+    this->buffer.clear();
+    this->buffer.reserve(RECORDING_BLOCK_SIZE);
+}
+
+void InputRecorder::writeLoop()
+{
+    std::unique_lock<std::mutex> guard{ this->lock };
+    while (true)
+    {
+        this->wake.wait(guard, [this]() { return !this->pending.empty() || this->closing; });
+
+        // Everything handed over is written before closing
+        if (this->pending.empty())
+        {
+            return;
+        }
+
+        std::vector<std::vector<unsigned char>> blocks;
+        blocks.swap(this->pending);
+
+        guard.unlock();
+        for (const std::vector<unsigned char>& block : blocks)
+        {
+            this->stream.write(reinterpret_cast<const char*>(block.data()), block.size());
+        }
+        guard.lock();
+    }
+}
+
+bool InputReplay::Open(const char* file)
+{
+    this->offset = 0;
+    this->input = 0;
+    this->ticksLeft = 0;
+    this->nextInput = END_OF_INPUT;
+
+    if (!this->file.Open(file))
+    {
+        std::cout << "ERROR::REPLAY: Failed to read " << file << std::endl;
+        return false;
+    }
+
+    if (this->file.Size() < sizeof(RecordingFileHeader))
+    {
+        std::cout << "ERROR::REPLAY: " << file << " is not a recording" << std::endl;
+        return false;
+    }
+
+    std::memcpy(&this->header, this->file.Data(), sizeof(RecordingFileHeader));
+    if (std::memcmp(this->header.Magic, "BREC", 4) != 0 || this->header.Version != RECORDING_FILE_VERSION || this->header.TickLength <= 0.0f)
+    {
+        std::cout << "ERROR::REPLAY: " << file << " is not a recording" << std::endl;
+        return false;
+    }
+
+    this->offset = sizeof(RecordingFileHeader);
+    return this->readEvent();
+}
+
+bool InputReplay::Next(SimInput& input)
+{
+    // Apply every event due at this tick
+    while (this->ticksLeft == 0)
+    {
+        if (this->nextInput == END_OF_INPUT)
+        {
+            return false;
+        }
+
+        this->input = this->nextInput;
+        if (!this->readEvent())
+        {
+            return false;
+        }
+    }
+
+    --this->ticksLeft;
+    input = decodeInput(this->input);
+    return true;
+}
+
+bool InputReplay::readEvent()
+{
+    const unsigned char* data = this->file.Data();
+    std::size_t size = this->file.Size();
+
+    // Ticks until the event, then its input byte
+    unsigned long long delta = 0;
+    unsigned int shift = 0;
+    while (this->offset < size && shift < 64)
+    {
+        unsigned char byte = data[this->offset++];
+        delta |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0)
+        {
+            if (this->offset == size)
+            {
+                break;
+            }
+
+            this->ticksLeft = delta;
+            this->nextInput = data[this->offset++];
+            return true;
+        }
+    }
+
+    // A recording cut short, say by a crash, still replays up to its last complete event
+    std::cout << "ERROR::REPLAY: Recording ends without an end marker" << std::endl;
+    this->ticksLeft = 0;
+    this->nextInput = END_OF_INPUT;
+    return false;
+}
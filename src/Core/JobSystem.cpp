@@ -0,0 +1,226 @@
+#include "Core/JobSystem.h"
+
+#include <utility>
+
+// A queued unit of work and the counter it reports to
+struct Job
+{
+    std::function<void()> Work;
+    JobCounter* Counter;
+};
+
+std::vector<std::thread> JobSystem::threads;
+std::vector<std::unique_ptr<JobSystem::Queue>> JobSystem::queues{ externalQueuesOnly() };
+std::atomic<bool> JobSystem::stopping{ false };
+std::atomic<unsigned int> JobSystem::queued{ 0 };
+std::atomic<unsigned int> JobSystem::externalThreads{ 0 };
+std::mutex JobSystem::sleepLock;
+std::condition_variable JobSystem::wake;
+
+// Failed attempts to take a job before a waiting thread goes to sleep
+const unsigned int WAIT_SPINS{ 16 };
+
+// Deque index of a worker thread
+static thread_local int workerIndex{ -1 };
+// Which external deque a thread that is not a worker uses, counted from the first one
+static thread_local int externalIndex{ -1 };
+
+std::vector<std::unique_ptr<JobSystem::Queue>> JobSystem::externalQueuesOnly()
+{
+    std::vector<std::unique_ptr<Queue>> external;
+    for (unsigned int i = 0; i < EXTERNAL_QUEUES; ++i)
+        external.push_back(std::make_unique<Queue>());
+    return external;
+}
+
+void JobSystem::Start(unsigned int workers)
+{
+    if (!threads.empty())
+        return;
+
+    if (workers == 0)
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    queues.clear();
+    for (unsigned int i = 0; i < workers + EXTERNAL_QUEUES; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    stopping = false;
+    for (unsigned int i = 0; i < workers; ++i)
+        threads.emplace_back(workerLoop, i);
+}
+
+void JobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+    threads.clear();
+
+    queues = externalQueuesOnly();
+}
+
+void JobSystem::Run(std::function<void()> work, JobCounter& counter, JobCounter* dependency)
+{
+    Job* job = new Job{ std::move(work), &counter };
+    counter.value.fetch_add(1, std::memory_order_relaxed);
+
+    if (dependency != nullptr)
+    {
+        // Park the job on the dependency; its last job queues it
+        std::lock_guard<std::mutex> lock(dependency->lock);
+        if (dependency->value.load(std::memory_order_acquire) != 0)
+        {
+            dependency->dependents.push_back(job);
+            return;
+        }
+    }
+
+    push(job);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    unsigned int misses = 0;
+    while (counter.value.load(std::memory_order_acquire) != 0)
+    {
+        if (Job* job = take())
+        {
+            execute(job);
+            misses = 0;
+        }
+        else if (++misses < WAIT_SPINS)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // The rest is running elsewhere: sleep until it is done, or until there is something to help with
+            std::unique_lock<std::mutex> lock(sleepLock);
+            wake.wait(lock, [&counter]() { return counter.value.load() == 0 || queued.load() > 0; });
+            misses = 0;
+        }
+    }
+
+    // The thread that finished the last job may still be releasing the counter; let it before the counter goes away
+    std::lock_guard<std::mutex> lock(counter.lock);
+}
+
+unsigned int JobSystem::self()
+{
+    if (workerIndex >= 0)
+        return static_cast<unsigned int>(workerIndex);
+
+    if (externalIndex < 0)
+        externalIndex = static_cast<int>(externalThreads.fetch_add(1) % EXTERNAL_QUEUES);
+    return static_cast<unsigned int>(queues.size() - EXTERNAL_QUEUES + externalIndex);
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    workerIndex = static_cast<int>(index);
+
+    while (true)
+    {
+        if (Job* job = take())
+        {
+            execute(job);
+            continue;
+        }
+
+        // Nothing to do: sleep until a job is queued, or leave once stopping with nothing left
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, []() { return queued.load() > 0 || stopping.load(); });
+        if (stopping && queued.load() == 0)
+            break;
+    }
+}
+
+void JobSystem::push(Job* job)
+{
+    Queue& queue = *queues[self()];
+    {
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        queue.Jobs.push_back(job);
+    }
+    queued.fetch_add(1);
+
+    // Taking the sleep lock orders this against a worker that just found nothing and is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+    }
+    wake.notify_one();
+}
+
+Job* JobSystem::take()
+{
+    unsigned int own = self();
+    unsigned int count = static_cast<unsigned int>(queues.size());
+
+    // Own deque first, newest job first while its data is still in cache
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        Queue& queue = *queues[(own + i) % count];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (queue.Jobs.empty())
+            continue;
+
+        Job* job;
+        if (i == 0)
+        {
+            job = queue.Jobs.back();
+            queue.Jobs.pop_back();
+        }
+        else
+        {
+            // Steal the oldest job, which tends to be the largest piece of work left
+            job = queue.Jobs.front();
+            queue.Jobs.pop_front();
+        }
+        queued.fetch_sub(1);
+        return job;
+    }
+
+    return nullptr;
+}
+
+void JobSystem::execute(Job* job)
+{
+    job->Work();
+    JobCounter& counter = *job->Counter;
+    delete job;
+    finish(counter);
+}
+
+void JobSystem::finish(JobCounter& counter)
+{
+    // Count down under the lock, so Wait cannot return while this thread still uses the counter
+    std::vector<Job*> ready;
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(counter.lock);
+        done = counter.value.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        if (done)
+            ready.swap(counter.dependents);
+    }
+
+    // Wake the threads sleeping in Wait; which one waits on this counter is not known
+    if (done)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+        }
+        wake.notify_all();
+    }
+
+    for (Job* job : ready)
+        push(job);
+}
@@ -0,0 +1,79 @@
+#include "Core/LevelStreamer.h"
+
+#include <iostream>
+#include <utility>
+
+LevelStreamer::LevelStreamer(unsigned int levelWidth, unsigned int levelHeight)
+    : levelWidth{ levelWidth }
+    , levelHeight{ levelHeight }
+{
+}
+
+LevelStreamer::~LevelStreamer()
+{
+    // Never leave the loader thread running past the streamer
+    if (this->next.valid())
+        this->next.wait();
+}
+
+void LevelStreamer::Start(std::vector<std::string> files, unsigned int first)
+{
+    if (this->next.valid())
+        this->next.wait();
+
+    this->files = std::move(files);
+    this->currentIndex = first;
+    this->current = GameLevel{};
+    ++this->version;
+    if (this->files.empty())
+        return;
+
+    this->current.Load(this->files[first].c_str(), this->levelWidth, this->levelHeight);
+    this->prefetch();
+    this->skipUnplayable();
+}
+
+void LevelStreamer::Advance()
+{
+    this->advance();
+    this->skipUnplayable();
+}
+
+void LevelStreamer::advance()
+{
+    if (!this->next.valid())
+        return;
+
+    this->current = this->next.get();
+    this->currentIndex = (this->currentIndex + 1) % this->Count();
+    ++this->version;
+    this->prefetch();
+}
+
+void LevelStreamer::skipUnplayable()
+{
+    for (unsigned int skipped = 0; !this->current.IsPlayable(); ++skipped)
+    {
+        // With nothing playable at all the empty level stays; it can never be completed, so the game does not spin
+        if (skipped == this->Count())
+        {
+            std::cout << "ERROR::LEVEL: No level has any bricks to clear" << std::endl;
+            return;
+        }
+
+        std::cout << "ERROR::LEVEL: " << this->files[this->currentIndex] << " has no bricks to clear, skipping it" << std::endl;
+        this->advance();
+    }
+}
+
+void LevelStreamer::prefetch()
+{
+    // The loader only touches its own level, copies of the file name and the level size
+    std::string file = this->files[(this->currentIndex + 1) % this->Count()];
+    unsigned int width = this->levelWidth, height = this->levelHeight;
+    this->next = std::async(std::launch::async, [file, width, height]() {
+        GameLevel level;
+        level.Load(file.c_str(), width, height);
+        return level;
+    });
+}
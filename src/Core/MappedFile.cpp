@@ -0,0 +1,101 @@
+#include "Core/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    this->Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const char* file)
+{
+    this->Close();
+
+    HANDLE handle = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr)
+    {
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(handle);
+        return false;
+    }
+
+    this->file = handle;
+    this->mapping = mapping;
+    this->data = static_cast<const unsigned char*>(view);
+    this->size = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (this->data != nullptr)
+    {
+        UnmapViewOfFile(this->data);
+        CloseHandle(this->mapping);
+        CloseHandle(this->file);
+    }
+
+    this->data = nullptr;
+    this->size = 0;
+    this->file = nullptr;
+    this->mapping = nullptr;
+}
+#else
+bool MappedFile::Open(const char* file)
+{
+    this->Close();
+
+    int descriptor = open(file, O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (view == MAP_FAILED)
+        return false;
+
+    this->data = static_cast<const unsigned char*>(view);
+    this->size = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (this->data != nullptr)
+        munmap(const_cast<unsigned char*>(this->data), this->size);
+
+    this->data = nullptr;
+    this->size = 0;
+}
+#endif
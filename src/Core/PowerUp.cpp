@@ -0,0 +1,92 @@
+#include "Core/PowerUp.h"
+#include "Core/GameSim.h"
+
+static void activateSpeed(GameSim& sim)
+{
+    for (BallObject& ball : sim.Balls)
+    {
+        ball.Velocity *= 1.2;
+    }
+}
+
+static void activateSticky(GameSim& sim)
+{
+    for (BallObject& ball : sim.Balls)
+    {
+        ball.Sticky = true;
+    }
+    sim.Player.Color = glm::vec3{ 1.0f, 0.5f, 1.0f };
+}
+
+static void deactivateSticky(GameSim& sim)
+{
+    for (BallObject& ball : sim.Balls)
+    {
+        ball.Sticky = false;
+    }
+    sim.Player.Color = glm::vec3{ 1.0f };
+}
+
+static void activatePassThrough(GameSim& sim)
+{
+    for (BallObject& ball : sim.Balls)
+    {
+        ball.PassThrough = true;
+        ball.Color = glm::vec3{ 1.0f, 0.5f, 0.5f };
+    }
+}
+
+static void deactivatePassThrough(GameSim& sim)
+{
+    for (BallObject& ball : sim.Balls)
+    {
+        ball.PassThrough = false;
+        ball.Color = glm::vec3{ 1.0f };
+    }
+}
+
+static void activatePadSizeIncrease(GameSim& sim)
+{
+    sim.Player.Size.x += 50;
+}
+
+static void activateConfuse(GameSim& sim)
+{
+    if (!sim.Chaos)
+    {
+        sim.Confuse = true;
+    }
+}
+
+static void deactivateConfuse(GameSim& sim)
+{
+    sim.Confuse = false;
+}
+
+static void activateChaos(GameSim& sim)
+{
+    if (!sim.Confuse)
+    {
+        sim.Chaos = true;
+    }
+}
+
+static void deactivateChaos(GameSim& sim)
+{
+    sim.Chaos = false;
+}
+
+static void activateMultiBall(GameSim& sim)
+{
+    sim.SplitBalls();
+}
+
+const PowerUpKind POWER_UP_KINDS[POWERUP_TYPE_COUNT]{
+    { glm::vec3{ 0.5f, 0.5f, 1.0f }, 0.0f, 75, "powerup_speed", activateSpeed, nullptr },
+    { glm::vec3{ 1.0f, 0.5f, 1.0f }, 20.0f, 75, "powerup_sticky", activateSticky, deactivateSticky },
+    { glm::vec3{ 0.5f, 1.5f, 1.0f }, 10.0f, 75, "powerup_passthrough", activatePassThrough, deactivatePassThrough },
+    { glm::vec3{ 1.0f, 0.6f, 0.4f }, 0.0f, 75, "powerup_increase", activatePadSizeIncrease, nullptr },
+    { glm::vec3{ 1.0f, 0.3f, 0.3f }, 15.0f, 75, "powerup_confuse", activateConfuse, deactivateConfuse },
+    { glm::vec3{ 0.9f, 0.25f, 0.25f }, 15.0f, 75, "powerup_chaos", activateChaos, deactivateChaos },
+    { glm::vec3{ 1.0f, 0.9f, 0.4f }, 0.0f, 75, "powerup_multiball", activateMultiBall, nullptr }
+};
@@ -0,0 +1,47 @@
+#include "Core/RenderSnapshot.h"
+
+static ObjectSnapshot captureObject(const GameObject& object)
+{
+    return ObjectSnapshot{ object.PreviousPosition, object.Position, object.Size, object.Velocity, object.Color, object.Rotation };
+}
+
+void RenderSnapshot::Capture(const GameSim& sim, unsigned long long tick, double time)
+{
+    this->Tick = tick;
+    this->Time = time;
+
+    this->State = sim.State;
+    this->Player = captureObject(sim.Player);
+    this->BallRadius = BALL_RADIUS;
+
+    // The vectors keep their capacity from earlier captures, so this does not allocate once warmed up
+    this->Balls.clear();
+    for (const BallObject& ball : sim.Balls)
+    {
+        this->Balls.push_back(captureObject(ball));
+    }
+
+    const BrickField& bricks = sim.Levels.Current().Bricks;
+    if (this->LevelVersion != sim.Levels.Version())
+    {
+        this->Bricks = bricks;
+        this->LevelVersion = sim.Levels.Version();
+    }
+    else
+    {
+        this->Bricks.CopyDestroyed(bricks);
+    }
+
+    this->PowerUps.clear();
+    for (const PowerUp& powerUp : sim.PowerUps)
+    {
+        if (!powerUp.Destroyed)
+        {
+            this->PowerUps.push_back(PowerUpSnapshot{ captureObject(powerUp), powerUp.Type });
+        }
+    }
+
+    this->Confuse = sim.Confuse;
+    this->Chaos = sim.Chaos;
+    this->Shake = sim.Shake;
+}
@@ -1,55 +1,237 @@
 #include "Core/ResourceManager.h"
 
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 #include <glad/glad.h>
 #include "stb/stb_image.h"
+#include "Core/Hash.h"
+#include "Core/ShaderCache.h"
 
 // Instantiate static variables
-std::map<std::string, Texture2D> ResourceManager::Textures;
-std::map<std::string, Shader> ResourceManager::Shaders;
+std::vector<ResourceManager::PendingShader> ResourceManager::pendingShaders;
+std::vector<ResourceManager::PendingTexture> ResourceManager::pendingTextures;
+std::vector<ResourceManager::PendingAtlas> ResourceManager::pendingAtlases;
+std::map<unsigned int, ResourceManager::PendingAtlas> ResourceManager::lazyAtlases;
+std::deque<Shader> ResourceManager::shaders;
+std::deque<Texture2D> ResourceManager::textures;
+std::deque<TextureAtlas> ResourceManager::atlases;
+std::vector<bool> ResourceManager::atlasPending;
+std::map<std::string, unsigned int> ResourceManager::shaderNames;
+std::map<std::string, unsigned int> ResourceManager::textureNames;
+std::map<std::string, unsigned int> ResourceManager::atlasNames;
 
-Shader ResourceManager::LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name)
+// Checks whether an asynchronous result can be taken without blocking
+template <typename T>
+static bool isReady(const std::future<T>& future)
 {
-    Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
-    return Shaders[name];
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 }
 
-Shader& ResourceManager::GetShader(std::string name)
+// Returns the slot for a name, adding an empty resource if the name is new; loading a name again replaces it
+template <typename T>
+static unsigned int intern(std::map<std::string, unsigned int>& names, std::deque<T>& storage, const std::string& name)
 {
-    return Shaders[name];
+    auto iter = names.find(name);
+    if (iter != names.end())
+    {
+        storage[iter->second] = T{};
+        return iter->second;
+    }
+
+    unsigned int index = static_cast<unsigned int>(storage.size());
+    storage.emplace_back();
+    names[name] = index;
+    return index;
+}
+
+ShaderHandle ResourceManager::LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name)
+{
+    unsigned int index = intern(shaderNames, shaders, name);
+    shaders[index] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
+    return ShaderHandle{ index };
+}
+
+TextureHandle ResourceManager::LoadTexture(const char* file, bool alpha, std::string name)
+{
+    unsigned int index = intern(textureNames, textures, name);
+    textures[index] = loadTextureFromFile(file, alpha);
+    return TextureHandle{ index };
+}
+
+AtlasHandle ResourceManager::LoadAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name)
+{
+    unsigned int index = createAtlas(files, name);
+
+    // Always decode to RGBA so every image shares the atlas format
+    std::vector<DecodedImage> images;
+    for (const auto& file : files)
+        images.push_back(decodeImage(file.first, file.second, 4));
+
+    buildAtlas(index, images);
+    return AtlasHandle{ index };
 }
 
-Texture2D ResourceManager::LoadTexture(const char* file, bool alpha, std::string name)
+TextureAtlas& ResourceManager::GetAtlas(AtlasHandle handle)
 {
-    Textures[name] = loadTextureFromFile(file, alpha);
-    return Textures[name];
+    assert(handle.Valid() && handle.Index < atlases.size());
+    if (atlasPending[handle.Index])
+    {
+        // First use: wait for the remaining decodes and upload
+        auto lazy = lazyAtlases.find(handle.Index);
+        std::vector<DecodedImage> images;
+        for (auto& image : lazy->second.Images)
+            images.push_back(image.get());
+        lazyAtlases.erase(lazy);
+        buildAtlas(handle.Index, images);
+    }
+
+    return atlases[handle.Index];
+}
+
+ShaderHandle ResourceManager::QueueShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name)
+{
+    unsigned int index = intern(shaderNames, shaders, name);
+    std::string vertex{ vShaderFile }, fragment{ fShaderFile }, geometry{ gShaderFile != nullptr ? gShaderFile : "" };
+    bool hasGeometry = gShaderFile != nullptr;
+    pendingShaders.push_back(PendingShader{ index, std::async(std::launch::async, [vertex, fragment, geometry, hasGeometry]() {
+        return readShaderSources(vertex.c_str(), fragment.c_str(), hasGeometry ? geometry.c_str() : nullptr);
+    }) });
+    return ShaderHandle{ index };
+}
+
+TextureHandle ResourceManager::QueueTexture(const char* file, bool alpha, std::string name)
+{
+    unsigned int index = intern(textureNames, textures, name);
+    std::string path{ file };
+    pendingTextures.push_back(PendingTexture{ index, alpha, std::async(std::launch::async, [path]() {
+        return decodeImage(path.c_str(), path, 0);
+    }) });
+    return TextureHandle{ index };
 }
 
-Texture2D& ResourceManager::GetTexture(std::string name)
+AtlasHandle ResourceManager::QueueAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name)
 {
-    return Textures[name];
+    unsigned int index = createAtlas(files, name);
+    pendingAtlases.push_back(PendingAtlas{ index, decodeAtlasImages(files) });
+    return AtlasHandle{ index };
+}
+
+AtlasHandle ResourceManager::QueueLazyAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name)
+{
+    unsigned int index = createAtlas(files, name);
+    lazyAtlases[index] = PendingAtlas{ index, decodeAtlasImages(files) };
+    atlasPending[index] = true;
+    return AtlasHandle{ index };
+}
+
+void ResourceManager::FinishLoading()
+{
+    while (!pendingShaders.empty() || !pendingTextures.empty() || !pendingAtlases.empty())
+    {
+        bool progress = false;
+
+        // Upload whatever has arrived, in any order
+        for (auto iter = pendingShaders.begin(); iter != pendingShaders.end();)
+        {
+            if (!isReady(iter->Sources))
+            {
+                ++iter;
+                continue;
+            }
+
+            shaders[iter->Index] = compileShader(iter->Sources.get());
+            iter = pendingShaders.erase(iter);
+            progress = true;
+        }
+
+        for (auto iter = pendingTextures.begin(); iter != pendingTextures.end();)
+        {
+            if (!isReady(iter->Image))
+            {
+                ++iter;
+                continue;
+            }
+
+            textures[iter->Index] = createTexture(iter->Image.get(), iter->Alpha);
+            iter = pendingTextures.erase(iter);
+            progress = true;
+        }
+
+        for (auto iter = pendingAtlases.begin(); iter != pendingAtlases.end();)
+        {
+            bool complete = true;
+            for (const auto& image : iter->Images)
+                complete = complete && isReady(image);
+            if (!complete)
+            {
+                ++iter;
+                continue;
+            }
+
+            std::vector<DecodedImage> images;
+            for (auto& image : iter->Images)
+                images.push_back(image.get());
+            buildAtlas(iter->Index, images);
+            iter = pendingAtlases.erase(iter);
+            progress = true;
+        }
+
+        // Nothing arrived yet; block briefly on one of the outstanding results
+        if (!progress)
+        {
+            if (!pendingShaders.empty())
+                pendingShaders.front().Sources.wait_for(std::chrono::milliseconds(1));
+            else if (!pendingTextures.empty())
+                pendingTextures.front().Image.wait_for(std::chrono::milliseconds(1));
+            else
+                pendingAtlases.front().Images.front().wait_for(std::chrono::milliseconds(1));
+        }
+    }
 }
 
 void ResourceManager::Clear()
 {
     // Properly delete all shaders
-    for (auto &iter : Shaders)
-        glDeleteProgram(iter.second.ID);
+    for (Shader& shader : shaders)
+        glDeleteProgram(shader.ID);
 
     // Properly delete all textures
-    for (auto &iter : Textures)
-        glDeleteTextures(1, &iter.second.ID);
+    for (Texture2D& texture : textures)
+        glDeleteTextures(1, &texture.ID);
+
+    // Properly delete all atlases
+    for (TextureAtlas& atlas : atlases)
+        glDeleteTextures(1, &atlas.Texture.ID);
+
+    // Let unused background decodes finish
+    lazyAtlases.clear();
+
+    shaders.clear();
+    textures.clear();
+    atlases.clear();
+    atlasPending.clear();
+    shaderNames.clear();
+    textureNames.clear();
+    atlasNames.clear();
 }
 
 Shader ResourceManager::loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile)
 {
-    // 1. Retrieve the vertex/fragment source code from file path
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
+    return compileShader(readShaderSources(vShaderFile, fShaderFile, gShaderFile));
+}
+
+Texture2D ResourceManager::loadTextureFromFile(const char* file, bool alpha)
+{
+    return createTexture(decodeImage(file, file, 0), alpha);
+}
+
+ResourceManager::ShaderSources ResourceManager::readShaderSources(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile)
+{
+    // Retrieve the vertex/fragment source code from file path
+    ShaderSources sources;
 
     try
     {
@@ -73,47 +255,53 @@ Shader ResourceManager::loadShaderFromFile(const char* vShaderFile, const char*
             std::stringstream gShaderStream;
             gShaderStream << geometryShaderFile.rdbuf();
             geometryShaderFile.close();
-            geometryCode = gShaderStream.str();
+            sources.Geometry = gShaderStream.str();
+            sources.HasGeometry = true;
         }
 
         // Convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        sources.Vertex = vShaderStream.str();
+        sources.Fragment = fShaderStream.str();
     }
     catch (std::exception e)
     {
         std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
     }
 
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
-    const char* gShaderCode = geometryCode.c_str();
-
-    // 2. Now create shader object from source code
-    Shader shader;
-    shader.Compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
-
-    return shader;
+    return sources;
 }
 
-Texture2D ResourceManager::loadTextureFromFile(const char* file, bool alpha)
+ResourceManager::DecodedImage ResourceManager::decodeImage(const char* file, std::string name, int channels)
 {
-    // Create texture object
-    Texture2D texture;
+    DecodedImage image;
+    image.Name = name;
 
-    if (alpha)
+    // Use the pre-decoded pixels if the cache was made from this exact file
+    std::uint64_t hash = 0;
+    bool hashed = HashFile(file, hash);
+    TextureCacheHeader header;
+    std::unique_ptr<MappedFile> cache = std::make_unique<MappedFile>();
+    if (hashed && LoadCachedImage(file, channels, hash, *cache, header))
     {
-        texture.InternalFormat = GL_RGBA8;
-        texture.ImageFormat = GL_RGBA;
+        image.Width = header.Width;
+        image.Height = header.Height;
+        image.Channels = header.Channels;
+        image.Cache = std::move(cache);
+        return image;
     }
 
     // Load image
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
+    unsigned char* data = stbi_load(file, &image.Width, &image.Height, &image.Channels, channels);
 
     if (data)
     {
-        texture.Generate(width, height, data);
+        if (channels != 0)
+            image.Channels = channels;
+        image.Pixels.assign(data, data + static_cast<size_t>(image.Width) * image.Height * image.Channels);
+
+        // Save the decoded pixels for the next launch
+        if (hashed)
+            StoreCachedImage(file, channels, hash, image.Width, image.Height, image.Channels, image.Pixels.data());
     }
     else
     {
@@ -123,5 +311,88 @@ Texture2D ResourceManager::loadTextureFromFile(const char* file, bool alpha)
     // And finally free image data
     stbi_image_free(data);
 
+    return image;
+}
+
+std::vector<std::future<ResourceManager::DecodedImage>> ResourceManager::decodeAtlasImages(const std::vector<std::pair<const char*, std::string>>& files)
+{
+    // Always decode to RGBA so every image shares the atlas format
+    std::vector<std::future<DecodedImage>> images;
+    for (const auto& file : files)
+    {
+        std::string path{ file.first }, name{ file.second };
+        images.push_back(std::async(std::launch::async, [path, name]() {
+            return decodeImage(path.c_str(), name, 4);
+        }));
+    }
+
+    return images;
+}
+
+Shader ResourceManager::compileShader(const ShaderSources& sources)
+{
+    // Stage sources are hashed with their terminators so moving text between stages changes the key
+    std::uint64_t hash = HashBytes(sources.Vertex.c_str(), sources.Vertex.size() + 1);
+    hash = HashBytes(sources.Fragment.c_str(), sources.Fragment.size() + 1, hash);
+    if (sources.HasGeometry)
+        hash = HashBytes(sources.Geometry.c_str(), sources.Geometry.size() + 1, hash);
+
+    // Prefer the binary from an earlier launch, compile from source if there is none or the driver rejects it
+    Shader shader;
+    if (LoadCachedProgram(hash, shader))
+        return shader;
+
+    // Now create shader object from source code
+    shader.Compile(sources.Vertex.c_str(), sources.Fragment.c_str(), sources.HasGeometry ? sources.Geometry.c_str() : nullptr);
+    StoreCachedProgram(hash, shader);
+
+    return shader;
+}
+
+Texture2D ResourceManager::createTexture(const DecodedImage& image, bool alpha)
+{
+    // Create texture object
+    Texture2D texture;
+
+    if (alpha)
+    {
+        texture.InternalFormat = GL_RGBA8;
+        texture.ImageFormat = GL_RGBA;
+    }
+
+    if (image.Valid())
+    {
+        texture.Generate(image.Width, image.Height, image.Data());
+    }
+
     return texture;
 }
+
+unsigned int ResourceManager::createAtlas(const std::vector<std::pair<const char*, std::string>>& files, std::string name)
+{
+    unsigned int index = intern(atlasNames, atlases, name);
+    if (atlasPending.size() < atlases.size())
+        atlasPending.resize(atlases.size(), false);
+    atlasPending[index] = false;
+
+    for (const auto& file : files)
+        atlases[index].Declare(file.second);
+
+    return index;
+}
+
+void ResourceManager::buildAtlas(unsigned int index, const std::vector<DecodedImage>& images)
+{
+    TextureAtlas& atlas = atlases[index];
+    atlasPending[index] = false;
+
+    for (const DecodedImage& image : images)
+    {
+        if (image.Valid())
+        {
+            atlas.Add(image.Name, image.Data(), image.Width, image.Height);
+        }
+    }
+
+    atlas.Build();
+}
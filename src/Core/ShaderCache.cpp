@@ -0,0 +1,100 @@
+#include "Core/ShaderCache.h"
+#include "Core/Hash.h"
+#include "Core/MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+// Path of the cache file for a set of sources
+static std::string cachePath(std::uint64_t sourceHash)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(sourceHash));
+    return std::string{ SHADER_CACHE_DIRECTORY } + "/" + name;
+}
+
+// Some drivers support no binary formats at all
+static bool binariesSupported()
+{
+    int formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+std::uint64_t ShaderDriverHash()
+{
+    std::uint64_t hash = HASH_SEED;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        const char* value = reinterpret_cast<const char*>(glGetString(name));
+        if (value != nullptr)
+            hash = HashBytes(value, std::strlen(value) + 1, hash);
+    }
+
+    return hash;
+}
+
+bool LoadCachedProgram(std::uint64_t sourceHash, Shader& shader)
+{
+    if (!binariesSupported())
+        return false;
+
+    MappedFile cache;
+    if (!cache.Open(cachePath(sourceHash).c_str()) || cache.Size() < sizeof(ShaderCacheHeader))
+        return false;
+
+    ShaderCacheHeader header;
+    std::memcpy(&header, cache.Data(), sizeof(header));
+    if (std::memcmp(header.Magic, "SPRG", 4) != 0 || header.Version != SHADER_CACHE_VERSION ||
+        header.SourceHash != sourceHash || header.DriverHash != ShaderDriverHash() ||
+        cache.Size() != sizeof(header) + header.Length)
+    {
+        return false;
+    }
+
+    return shader.LoadBinary(header.Format, cache.Data() + sizeof(header), static_cast<int>(header.Length));
+}
+
+bool StoreCachedProgram(std::uint64_t sourceHash, const Shader& shader)
+{
+    unsigned int format = 0;
+    std::vector<unsigned char> binary;
+    if (!binariesSupported() || !shader.GetBinary(format, binary))
+        return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(SHADER_CACHE_DIRECTORY, error);
+
+    std::string path = cachePath(sourceHash);
+    std::string temporary = path + ".tmp";
+
+    ShaderCacheHeader header{ { 'S', 'P', 'R', 'G' }, SHADER_CACHE_VERSION, format,
+        static_cast<std::uint32_t>(binary.size()), sourceHash, ShaderDriverHash() };
+    {
+        std::ofstream fstream(temporary, std::ios::binary);
+        fstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        fstream.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        if (!fstream)
+        {
+            std::cout << "ERROR::SHADER_CACHE: Failed to write " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::cout << "ERROR::SHADER_CACHE: Failed to write " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
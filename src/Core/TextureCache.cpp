@@ -0,0 +1,80 @@
+#include "Core/TextureCache.h"
+#include "Core/Hash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+bool HashFile(const char* file, std::uint64_t& hash)
+{
+    MappedFile mapped;
+    if (!mapped.Open(file))
+        return false;
+
+    hash = HashBytes(mapped.Data(), mapped.Size());
+    return true;
+}
+
+std::string TextureCachePath(const char* source, int channels)
+{
+    // Flatten the source path into one file name
+    std::string name{ source };
+    for (char& c : name)
+    {
+        if (c == '/' || c == '\\' || c == ':')
+            c = '_';
+    }
+
+    return std::string{ TEXTURE_CACHE_DIRECTORY } + "/" + name + "." + std::to_string(channels) + ".tex";
+}
+
+bool LoadCachedImage(const char* source, int channels, std::uint64_t sourceHash, MappedFile& cache, TextureCacheHeader& header)
+{
+    if (!cache.Open(TextureCachePath(source, channels).c_str()) || cache.Size() < sizeof(TextureCacheHeader))
+        return false;
+
+    // Reject stale or foreign files
+    std::memcpy(&header, cache.Data(), sizeof(header));
+    if (std::memcmp(header.Magic, "TCCH", 4) != 0 || header.Version != TEXTURE_CACHE_VERSION || header.SourceHash != sourceHash ||
+        cache.Size() != sizeof(header) + static_cast<std::size_t>(header.Width) * header.Height * header.Channels)
+    {
+        cache.Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool StoreCachedImage(const char* source, int channels, std::uint64_t sourceHash,
+    int width, int height, int pixelChannels, const unsigned char* pixels)
+{
+    std::error_code error;
+    std::filesystem::create_directories(TEXTURE_CACHE_DIRECTORY, error);
+
+    std::string path = TextureCachePath(source, channels);
+    std::string temporary = path + ".tmp";
+
+    TextureCacheHeader header{ { 'T', 'C', 'C', 'H' }, TEXTURE_CACHE_VERSION,
+        static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), static_cast<std::uint32_t>(pixelChannels), 0, sourceHash };
+    {
+        std::ofstream fstream(temporary, std::ios::binary);
+        fstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        fstream.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(width) * height * pixelChannels);
+        if (!fstream)
+        {
+            std::cout << "ERROR::TEXTURE_CACHE: Failed to write " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::cout << "ERROR::TEXTURE_CACHE: Failed to write " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
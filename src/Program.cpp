@@ -1,10 +1,18 @@
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <Core/Game.h>
+#include <Core/JobSystem.h>
 #include <Core/ResourceManager.h>
+#include <Rendering/RenderState.h>
 
 // GLFW function declerations
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
@@ -13,6 +21,16 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 // Debug callback
 void message_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const* message, void const* user_param);
 
+// Runs the simulation without a window for the given amount of simulated seconds in ticks of the given length,
+// starting with at least the given number of balls
+int run_headless(float seconds, unsigned int balls, float tick);
+
+// Replays a recording without a window as fast as possible, printing a rolling state hash every 'hashInterval' ticks
+int run_replay(const char* file, unsigned long long hashInterval);
+
+// Compiles every text level in the given directory into a binary level next to it
+int compile_levels(const char* directory);
+
 // The Width of the rendering window
 const unsigned int SCR_WIDTH = 800;
 // The Height of the rendering window
@@ -23,6 +41,39 @@ Game Breakout{ SCR_WIDTH, SCR_HEIGHT };
 // The main function
 int main(int argc, char* argv[])
 {
+    // Headless soak run: Breakout --headless [seconds] [balls] [tick]
+    if (argc > 1 && std::strcmp(argv[1], "--headless") == 0)
+    {
+        float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 600.0f;
+        unsigned int balls = argc > 3 ? static_cast<unsigned int>(std::atoi(argv[3])) : 1;
+        float tick = argc > 4 ? static_cast<float>(std::atof(argv[4])) : SIM_TICK;
+
+        // Both have to be positive, and their ratio has to fit the tick counter
+        if (!std::isfinite(seconds) || !std::isfinite(tick) || seconds <= 0.0f || tick <= 0.0f ||
+            !(static_cast<double>(seconds) / tick < 1e18))
+        {
+            std::cout << "Usage: Breakout --headless [seconds] [balls] [tick], with seconds and tick greater than zero" << std::endl;
+            return -1;
+        }
+
+        return run_headless(seconds, balls, tick);
+    }
+
+    // Replay: Breakout --replay file [hash interval]
+    if (argc > 2 && std::strcmp(argv[1], "--replay") == 0)
+    {
+        return run_replay(argv[2], argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 120);
+    }
+
+    // Recording: Breakout --record file
+    const char* recording = argc > 2 && std::strcmp(argv[1], "--record") == 0 ? argv[2] : nullptr;
+
+    // Level compiler: Breakout --compile-levels [directory]
+    if (argc > 1 && std::strcmp(argv[1], "--compile-levels") == 0)
+    {
+        return compile_levels(argc > 2 ? argv[2] : "assets/levels");
+    }
+
     // Initialize GLFW
     if (!glfwInit())
     {
@@ -66,38 +117,50 @@ int main(int argc, char* argv[])
     // Configure OpenGL
     glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
     glfwSwapInterval(1);
+    // Worker threads for parallel simulation and particle updates
+    JobSystem::Start();
     // Initialize game
     Breakout.Init();
+    if (recording != nullptr)
+    {
+        Breakout.Recorder.Open(recording, Breakout.Sim, SIM_TICK);
+    }
 
-    // DeltaTime variables
-    float deltaTime = 0.0f;
-    float lastFrame = 0.0f;
+#ifdef _DEBUG
+    // Second of the last render state report
+    long long lastReport = static_cast<long long>(glfwGetTime());
+#endif
 
     // Debug
     glEnable(GL_DEBUG_OUTPUT);
     glDebugMessageCallback(message_callback, nullptr);
 
+    // Simulate on a separate thread; this one only polls input and renders
+    Breakout.Start();
+
     // Game loop
     while (!glfwWindowShouldClose(window))
     {
-        // Calculate delta time
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+        // Start counting state changes for this frame
+        RenderState::BeginFrame();
+#ifdef _DEBUG
+        // Report the previous frame's state changes once per second
+        long long second = static_cast<long long>(glfwGetTime());
+        if (second != lastReport)
+        {
+            lastReport = second;
+            std::cout << "RENDERSTATE: " << RenderState::LastFrame.Issued << " issued, "
+                << RenderState::LastFrame.Elided << " elided" << std::endl;
+        }
+#endif
 
         // Poll events
         glfwPollEvents();
 
-        // Manage user input
-        Breakout.ProcessInput(deltaTime);
-
-        // Update game state
-        Breakout.Update(deltaTime);
-
         // Render
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
@@ -107,6 +170,10 @@ int main(int argc, char* argv[])
         glfwSwapBuffers(window);
     }
 
+    Breakout.Stop();
+    Breakout.Recorder.Close();
+    JobSystem::Stop();
+
     // Delete all resources as loaded using the ResourceManager
     ResourceManager::Clear();
 
@@ -145,6 +212,118 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     }
 }
 
+// The headless run function
+int run_headless(float seconds, unsigned int balls, float tick)
+{
+    JobSystem::Start();
+    GameSim sim{ SCR_WIDTH, SCR_HEIGHT };
+    // The same seed every run, so soak runs repeat
+    sim.Init(1);
+
+    // Stress runs start with the ball split up as far as asked
+    while (sim.Balls.size() < std::min(balls, MAX_BALLS))
+    {
+        sim.SplitBalls();
+    }
+
+    unsigned long long ticks = static_cast<unsigned long long>(seconds / tick);
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned long long i = 0; i < ticks; ++i)
+    {
+        // Autopilot: keep the paddle under the first ball and launch it whenever it is stuck
+        const BallObject& ball = sim.Balls.front();
+        float ballCenter = ball.Position.x + ball.Radius;
+        float paddleCenter = sim.Player.Position.x + sim.Player.Size.x / 2.0f;
+
+        SimInput input;
+        input.Left = ballCenter < paddleCenter - 10.0f;
+        input.Right = ballCenter > paddleCenter + 10.0f;
+        input.Launch = true;
+
+        sim.Step(input, tick);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Simulated " << seconds << "s (" << ticks << " ticks) in " << elapsed.count() << "s, "
+        << sim.Balls.size() << " balls left" << std::endl;
+
+    JobSystem::Stop();
+
+    return 0;
+}
+
+// The replay function
+int run_replay(const char* file, unsigned long long hashInterval)
+{
+    InputReplay replay;
+    if (!replay.Open(file))
+    {
+        return -1;
+    }
+
+    const RecordingFileHeader& header = replay.Header();
+    JobSystem::Start();
+    GameSim sim{ header.Width, header.Height };
+    sim.Init(header.Seed);
+
+    // Each hash covers the state at its tick and every hash before it, so the first mismatch between two runs shows
+    // roughly where they parted ways
+    std::uint64_t hash = sim.Hash();
+    unsigned long long ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    SimInput input;
+    while (replay.Next(input))
+    {
+        sim.Step(input, header.TickLength);
+        ++ticks;
+
+        if (hashInterval > 0 && ticks % hashInterval == 0)
+        {
+            hash = sim.Hash(hash);
+            std::cout << ticks << " " << std::hex << hash << std::dec << std::endl;
+        }
+    }
+
+    // The final state, whatever the interval
+    hash = sim.Hash(hash);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Replayed " << ticks << " ticks (" << ticks * header.TickLength << "s) in " << elapsed.count() << "s, final hash "
+        << std::hex << hash << std::dec << std::endl;
+
+    JobSystem::Stop();
+
+    return 0;
+}
+
+// The level compile function
+int compile_levels(const char* directory)
+{
+    std::error_code error;
+    int failed = 0;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.path().extension() != ".level")
+            continue;
+
+        std::filesystem::path target = entry.path();
+        target.replace_extension(".blevel");
+        if (GameLevel::Compile(entry.path().string().c_str(), target.string().c_str()))
+            std::cout << "Compiled " << entry.path().string() << " -> " << target.string() << std::endl;
+        else
+            ++failed;
+    }
+
+    if (error)
+    {
+        std::cout << "ERROR::LEVEL: Failed to list " << directory << ": " << error.message() << std::endl;
+        return -1;
+    }
+
+    return failed == 0 ? 0 : -1;
+}
+
 void message_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const* message, void const* user_param)
 {
     auto const src_str = [source]() {
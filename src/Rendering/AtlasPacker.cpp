@@ -0,0 +1,105 @@
+#include "Rendering/AtlasPacker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+// Shelf-packs the images into an atlas of the given width and returns the used height
+static unsigned int packShelves(const std::vector<glm::uvec2>& sizes, const std::vector<unsigned int>& order,
+    unsigned int padding, unsigned int width, std::vector<AtlasRect>& rects)
+{
+    unsigned int x = 0, y = 0, shelfHeight = 0;
+
+    for (unsigned int index : order)
+    {
+        unsigned int paddedWidth = sizes[index].x + 2 * padding;
+        unsigned int paddedHeight = sizes[index].y + 2 * padding;
+
+        // Start a new shelf when the image does not fit on the current one
+        if (x + paddedWidth > width)
+        {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        rects[index] = AtlasRect{ x + padding, y + padding, sizes[index].x, sizes[index].y };
+        x += paddedWidth;
+        shelfHeight = std::max(shelfHeight, paddedHeight);
+    }
+
+    return y + shelfHeight;
+}
+
+static unsigned int nextPowerOfTwo(unsigned int value)
+{
+    unsigned int result = 1;
+    while (result < value)
+        result *= 2;
+    return result;
+}
+
+bool PackAtlas(const std::vector<glm::uvec2>& sizes, unsigned int padding, unsigned int maxWidth, unsigned int maxHeight,
+    std::vector<AtlasRect>& rects, glm::uvec2& atlasSize)
+{
+    // Tallest first, then widest, then input order
+    std::vector<unsigned int> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&sizes](unsigned int a, unsigned int b) {
+        if (sizes[a].y != sizes[b].y)
+            return sizes[a].y > sizes[b].y;
+        if (sizes[a].x != sizes[b].x)
+            return sizes[a].x > sizes[b].x;
+        return a < b;
+    });
+
+    unsigned int widest = 1;
+    for (const glm::uvec2& size : sizes)
+        widest = std::max(widest, size.x + 2 * padding);
+
+    bool found = false;
+    std::vector<AtlasRect> candidate(sizes.size());
+    for (unsigned int width = nextPowerOfTwo(widest); width <= maxWidth; width *= 2)
+    {
+        unsigned int height = nextPowerOfTwo(packShelves(sizes, order, padding, width, candidate));
+        if (height > maxHeight)
+            continue;
+
+        // Keep the smallest area, the narrower atlas on ties
+        if (!found || static_cast<unsigned long long>(width) * height < static_cast<unsigned long long>(atlasSize.x) * atlasSize.y)
+        {
+            rects = candidate;
+            atlasSize = glm::uvec2{ width, height };
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+std::vector<unsigned char> ComposeAtlas(const std::vector<const unsigned char*>& images, const std::vector<AtlasRect>& rects,
+    unsigned int padding, glm::uvec2 atlasSize)
+{
+    std::vector<unsigned char> pixels(atlasSize.x * atlasSize.y * 4, 0);
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const AtlasRect& rect = rects[i];
+
+        // Padding rows repeat the first and last image row, padding columns the first and last pixel of their row
+        for (unsigned int row = 0; row < rect.Height + 2 * padding; ++row)
+        {
+            unsigned int sourceRow = std::min(std::max(row, padding) - padding, rect.Height - 1);
+            const unsigned char* source = images[i] + sourceRow * rect.Width * 4;
+            unsigned char* target = &pixels[((rect.Y - padding + row) * atlasSize.x + rect.X - padding) * 4];
+
+            for (unsigned int column = 0; column < padding; ++column)
+            {
+                std::memcpy(target + column * 4, source, 4);
+                std::memcpy(target + (padding + rect.Width + column) * 4, source + (rect.Width - 1) * 4, 4);
+            }
+            std::memcpy(target + padding * 4, source, rect.Width * 4);
+        }
+    }
+
+    return pixels;
+}
@@ -0,0 +1,24 @@
+#include "Rendering/FrameUniforms.h"
+
+#include <glad/glad.h>
+
+FrameUniforms::FrameUniforms()
+    : Projection{ 1.0f }
+    , Time{ 0.0f }
+    , UBO{ 0 }
+{
+    glCreateBuffers(1, &this->UBO);
+    glNamedBufferStorage(this->UBO, sizeof(Block), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, this->UBO);
+}
+
+FrameUniforms::~FrameUniforms()
+{
+    glDeleteBuffers(1, &this->UBO);
+}
+
+void FrameUniforms::Upload()
+{
+    Block block{ this->Projection, this->Time, { 0.0f, 0.0f, 0.0f } };
+    glNamedBufferSubData(this->UBO, 0, sizeof(Block), &block);
+}
@@ -1,62 +1,82 @@
 #include "Rendering/ParticleGenerator.h"
+#include "Rendering/RenderState.h"
 
-#include <glad/glad.h>
+#include <cstddef>
 
-// Stores the index of the last particle used
-unsigned int lastUsedParticle{ 0 };
+#include <glad/glad.h>
 
-ParticleGenerator::ParticleGenerator(Shader shader, Texture2D texture, unsigned int amount)
-    : amount{ amount }
+ParticleGenerator::ParticleGenerator(Shader shader, Texture2D texture, unsigned int amount, AtlasRegion region)
+    : particles{ amount }
+    , amount{ amount }
     , shader{ shader }
     , texture{ texture }
+    , region{ region }
+    , regionLocation{ shader.Location("region") }
 {
     init();
 }
 
+ParticleGenerator::~ParticleGenerator()
+{
+    for (GLsync fence : this->fences)
+    {
+        if (fence != nullptr)
+            glDeleteSync(fence);
+    }
+    glUnmapNamedBuffer(this->instanceVBO);
+    glDeleteBuffers(1, &this->instanceVBO);
+    glDeleteVertexArrays(1, &this->VAO);
+}
+
 void ParticleGenerator::Update(float deltaTime, GameObject& object, unsigned int newParticles, glm::vec2 offset)
 {
     // Add new particles
     for (unsigned int i = 0; i < newParticles; ++i)
     {
-        int unusedParticle = firstUnusedParticle();
-        respawnParticle(this->particles[unusedParticle], object, offset);
+        respawnParticle(object, offset);
     }
 
     // Update all particles
-    for (unsigned int i = 0; i < this->amount; ++i)
-    {
-        Particle& p = this->particles[i];
-        p.Life -= deltaTime;
-        if (p.Life > 0.0f)
-        {
-            p.Position -= p.Velocity * deltaTime;
-            p.Color.a -= deltaTime * 2.5f;
-        }
-    }
+    this->particles.Update(deltaTime);
 }
 
 void ParticleGenerator::Draw()
 {
     // Use additive blending to give it a 'glow' effect
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    RenderState::BlendFunc(GL_SRC_ALPHA, GL_ONE);
     this->shader.Use();
+    this->texture.Bind();
+    RenderState::BindVertexArray(this->VAO);
+    this->shader.SetVector4f(this->regionLocation, glm::vec4{ this->region.Offset, this->region.Scale });
 
-    for (const Particle& particle : this->particles)
+    // Wait until the GPU is done with the region written PARTICLE_BUFFER_REGIONS draws ago
+    GLsync& fence = this->fences[this->currentRegion];
+    if (fence != nullptr)
     {
-        if (particle.Life > 0.0f)
-        {
-            this->shader.SetVector2f("offset", particle.Position);
-            this->shader.SetVector4f("color", particle.Color);
-            this->texture.Bind();
-                
-            glBindVertexArray(this->VAO);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-            glBindVertexArray(0);
-        }
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
     }
 
+    // Write the live particles and draw them all at once
+    unsigned int first = this->currentRegion * this->amount;
+    unsigned int count = this->particles.Count();
+    ParticleInstance* target = this->instances + first;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        target[i].Offset = glm::vec2{ this->particles.PositionX[i], this->particles.PositionY[i] };
+        target[i].Color = glm::vec4{ this->particles.ColorR[i], this->particles.ColorG[i], this->particles.ColorB[i], this->particles.ColorA[i] };
+    }
+
+    if (count > 0)
+    {
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, count, first);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    this->currentRegion = (this->currentRegion + 1) % PARTICLE_BUFFER_REGIONS;
+
     // Dont forget to reset to default blending mode
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void ParticleGenerator::init()
@@ -83,57 +103,37 @@ void ParticleGenerator::init()
     // Bind the VBO to the VAO at binding index 0
     glVertexArrayVertexBuffer(this->VAO, 0, VBO, 0, sizeof(float) * 4);
 
-    // Setup vertex attribute 0: position (2 floats, starting at offset 0)
+    // Setup vertex attribute 0: position and texture coordinates (4 floats, starting at offset 0)
     glEnableVertexArrayAttrib(this->VAO, 0);
-    glVertexArrayAttribFormat(this->VAO, 0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribFormat(this->VAO, 0, 4, GL_FLOAT, GL_FALSE, 0);
     glVertexArrayAttribBinding(this->VAO, 0, 0);
 
-    // Setup vertex attribute 1: color (2 floats, starting at offset 2*sizeof(float))
-    glEnableVertexArrayAttrib(this->VAO, 1);
-    glVertexArrayAttribFormat(this->VAO, 1, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2);
-    glVertexArrayAttribBinding(this->VAO, 1, 0);
+    // Persistently mapped instance buffer; coherent, so writes need no explicit flush
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLsizeiptr bufferSize = PARTICLE_BUFFER_REGIONS * this->amount * sizeof(ParticleInstance);
+    glCreateBuffers(1, &this->instanceVBO);
+    glNamedBufferStorage(this->instanceVBO, bufferSize, nullptr, flags);
+    this->instances = static_cast<ParticleInstance*>(glMapNamedBufferRange(this->instanceVBO, 0, bufferSize, flags));
 
-    // Create this->amount default particle instances
-    for (unsigned int i = 0; i < this->amount; ++i)
-    {
-        this->particles.push_back(Particle());
-    }
-}
+    // Bind the instance buffer at binding index 1, advancing once per instance
+    glVertexArrayVertexBuffer(this->VAO, 1, this->instanceVBO, 0, sizeof(ParticleInstance));
+    glVertexArrayBindingDivisor(this->VAO, 1, 1);
 
-unsigned int ParticleGenerator::firstUnusedParticle()
-{
-    // First search from last used particle, this will usually return almost instantly
-    for (unsigned int i = lastUsedParticle; i < this->amount; ++i)
-    {
-        if (this->particles[i].Life <= 0.0f)
-        {
-            lastUsedParticle = i;
-            return i;
-        }
-    }
-
-    // Otherwise, do a linear search
-    for (unsigned int i = 0; i < lastUsedParticle; ++i)
-    {
-        if (this->particles[i].Life <= 0.0f)
-        {
-            lastUsedParticle = i;
-            return i;
-        }
-    }
-
-    lastUsedParticle = 0;
+    // Setup vertex attribute 1: particle offset
+    glEnableVertexArrayAttrib(this->VAO, 1);
+    glVertexArrayAttribFormat(this->VAO, 1, 2, GL_FLOAT, GL_FALSE, offsetof(ParticleInstance, Offset));
+    glVertexArrayAttribBinding(this->VAO, 1, 1);
 
-    return 0;
+    // Setup vertex attribute 2: particle color
+    glEnableVertexArrayAttrib(this->VAO, 2);
+    glVertexArrayAttribFormat(this->VAO, 2, 4, GL_FLOAT, GL_FALSE, offsetof(ParticleInstance, Color));
+    glVertexArrayAttribBinding(this->VAO, 2, 1);
 }
 
-void ParticleGenerator::respawnParticle(Particle& particle, GameObject& object, glm::vec2 offset)
+void ParticleGenerator::respawnParticle(GameObject& object, glm::vec2 offset)
 {
     float random = ((rand() % 100) - 50) / 10.0f;
     float rColor = 0.5f + ((rand() % 100) / 100.0f);
 
-    particle.Position = object.Position + random + offset;
-    particle.Color = glm::vec4{ rColor, rColor, rColor, 1.0f };
-    particle.Life = 1.0f;
-    particle.Velocity = object.Velocity * 0.1f;
+    this->particles.Spawn(object.Position + random + offset, object.Velocity * 0.1f, glm::vec4{ rColor, rColor, rColor, 1.0f }, 1.0f);
 }
@@ -0,0 +1,138 @@
+#include "Rendering/ParticlePool.h"
+
+#include <Core/JobSystem.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+// Alpha lost per second of a particle's life
+const float PARTICLE_FADE{ 2.5f };
+// Particles per job when updating in parallel; a multiple of PARTICLE_LANES, as UpdateRange requires
+const unsigned int PARTICLE_GRAIN{ 8192 };
+
+ParticlePool::ParticlePool(unsigned int capacity)
+    : count{ 0 }
+    , capacity{ capacity }
+    , overwrite{ 0 }
+{
+    unsigned int padded = (capacity + PARTICLE_LANES - 1) / PARTICLE_LANES * PARTICLE_LANES;
+    for (std::vector<float>* array : { &PositionX, &PositionY, &VelocityX, &VelocityY, &ColorR, &ColorG, &ColorB, &ColorA, &Life })
+    {
+        array->assign(padded, 0.0f);
+    }
+}
+
+void ParticlePool::Spawn(glm::vec2 position, glm::vec2 velocity, glm::vec4 color, float life)
+{
+    unsigned int index;
+    if (this->count < this->capacity)
+    {
+        index = this->count++;
+    }
+    else
+    {
+        index = this->overwrite;
+        this->overwrite = (this->overwrite + 1) % this->capacity;
+    }
+
+    this->PositionX[index] = position.x;
+    this->PositionY[index] = position.y;
+    this->VelocityX[index] = velocity.x;
+    this->VelocityY[index] = velocity.y;
+    this->ColorR[index] = color.r;
+    this->ColorG[index] = color.g;
+    this->ColorB[index] = color.b;
+    this->ColorA[index] = color.a;
+    this->Life[index] = life;
+}
+
+void ParticlePool::Update(float deltaTime)
+{
+    // The ranges are disjoint, so they can run on any workers; retiring reorders particles and stays serial
+    JobSystem::ParallelFor(this->count, PARTICLE_GRAIN, [this, deltaTime](unsigned int first, unsigned int last) {
+        this->UpdateRange(first, last, deltaTime);
+    });
+    this->RetireDead();
+}
+
+void ParticlePool::UpdateRange(unsigned int first, unsigned int last, float deltaTime)
+{
+    // Particles that die during this step keep their position and color, like dead ones
+#if defined(__AVX__)
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 fade = _mm256_set1_ps(deltaTime * PARTICLE_FADE);
+    const __m256 zero = _mm256_setzero_ps();
+
+    // The storage is padded, so the final partial block can be processed whole
+    for (unsigned int i = first; i < last; i += PARTICLE_LANES)
+    {
+        __m256 life = _mm256_sub_ps(_mm256_loadu_ps(&this->Life[i]), dt);
+        __m256 alive = _mm256_cmp_ps(life, zero, _CMP_GT_OQ);
+        __m256 step = _mm256_and_ps(alive, dt);
+
+        _mm256_storeu_ps(&this->Life[i], life);
+        _mm256_storeu_ps(&this->PositionX[i], _mm256_sub_ps(_mm256_loadu_ps(&this->PositionX[i]), _mm256_mul_ps(_mm256_loadu_ps(&this->VelocityX[i]), step)));
+        _mm256_storeu_ps(&this->PositionY[i], _mm256_sub_ps(_mm256_loadu_ps(&this->PositionY[i]), _mm256_mul_ps(_mm256_loadu_ps(&this->VelocityY[i]), step)));
+        _mm256_storeu_ps(&this->ColorA[i], _mm256_sub_ps(_mm256_loadu_ps(&this->ColorA[i]), _mm256_and_ps(alive, fade)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 fade = _mm_set1_ps(deltaTime * PARTICLE_FADE);
+    const __m128 zero = _mm_setzero_ps();
+
+    // The storage is padded, so the final partial block can be processed whole
+    for (unsigned int i = first; i < last; i += PARTICLE_LANES)
+    {
+        __m128 life = _mm_sub_ps(_mm_loadu_ps(&this->Life[i]), dt);
+        __m128 alive = _mm_cmpgt_ps(life, zero);
+        __m128 step = _mm_and_ps(alive, dt);
+
+        _mm_storeu_ps(&this->Life[i], life);
+        _mm_storeu_ps(&this->PositionX[i], _mm_sub_ps(_mm_loadu_ps(&this->PositionX[i]), _mm_mul_ps(_mm_loadu_ps(&this->VelocityX[i]), step)));
+        _mm_storeu_ps(&this->PositionY[i], _mm_sub_ps(_mm_loadu_ps(&this->PositionY[i]), _mm_mul_ps(_mm_loadu_ps(&this->VelocityY[i]), step)));
+        _mm_storeu_ps(&this->ColorA[i], _mm_sub_ps(_mm_loadu_ps(&this->ColorA[i]), _mm_and_ps(alive, fade)));
+    }
+#else
+    for (unsigned int i = first; i < last; ++i)
+    {
+        this->Life[i] -= deltaTime;
+        if (this->Life[i] > 0.0f)
+        {
+            this->PositionX[i] -= this->VelocityX[i] * deltaTime;
+            this->PositionY[i] -= this->VelocityY[i] * deltaTime;
+            this->ColorA[i] -= deltaTime * PARTICLE_FADE;
+        }
+    }
+#endif
+}
+
+void ParticlePool::RetireDead()
+{
+    unsigned int i = 0;
+    while (i < this->count)
+    {
+        if (this->Life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        // Move the last live particle into the freed slot and test it next
+        unsigned int last = --this->count;
+        this->PositionX[i] = this->PositionX[last];
+        this->PositionY[i] = this->PositionY[last];
+        this->VelocityX[i] = this->VelocityX[last];
+        this->VelocityY[i] = this->VelocityY[last];
+        this->ColorR[i] = this->ColorR[last];
+        this->ColorG[i] = this->ColorG[last];
+        this->ColorB[i] = this->ColorB[last];
+        this->ColorA[i] = this->ColorA[last];
+        this->Life[i] = this->Life[last];
+    }
+
+    if (this->overwrite >= this->count)
+        this->overwrite = 0;
+}
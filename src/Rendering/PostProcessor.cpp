@@ -1,4 +1,5 @@
 #include "Rendering/PostProcessor.h"
+#include "Rendering/RenderState.h"
 
 #include <glad/glad.h>
 
@@ -11,6 +12,9 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned height)
     , Confuse{ false }
     , Chaos{ false }
     , Shake{ false }
+    , confuseLocation{ shader.Location("confuse") }
+    , chaosLocation{ shader.Location("chaos") }
+    , shakeLocation{ shader.Location("shake") }
 {
     // Initialize renderbuffer/framebuffer object
     glCreateFramebuffers(1, &this->MSFBO);
@@ -50,26 +54,26 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned height)
         {  0.0f,   -offset  },  // bottom-center
         {  offset, -offset  }   // bottom-right    
     };
-    glUniform2fv(glGetUniformLocation(this->PostProcessingShader.ID, "offsets"), 9, (float*)offsets);
+    glUniform2fv(this->PostProcessingShader.Location("offsets"), 9, (float*)offsets);
 
     int edge_kernel[9]{
         -1, -1, -1,
         -1,  8, -1,
         -1, -1, -1
     };
-    glUniform1iv(glGetUniformLocation(this->PostProcessingShader.ID, "edge_kernel"), 9, edge_kernel);
+    glUniform1iv(this->PostProcessingShader.Location("edge_kernel"), 9, edge_kernel);
     
     float blur_kernel[9]{
     1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
     2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
     1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
     };
-    glUniform1fv(glGetUniformLocation(this->PostProcessingShader.ID, "blur_kernel"), 9, blur_kernel);
+    glUniform1fv(this->PostProcessingShader.Location("blur_kernel"), 9, blur_kernel);
 }
 
 void PostProcessor::BeginRender()
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, this->MSFBO);
+    RenderState::BindFramebuffer(this->MSFBO);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -77,22 +81,20 @@ void PostProcessor::BeginRender()
 void PostProcessor::EndRender()
 {
     glBlitNamedFramebuffer(this->MSFBO, this->FBO, 0, 0, this->Width, this->Height, 0, 0, this->Width, this->Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    RenderState::BindFramebuffer(0);
 }
 
-void PostProcessor::Render(float time)
+void PostProcessor::Render()
 {
-    // set uniforms/options
+    // set uniforms/options; time comes from the frame uniform block
     this->PostProcessingShader.Use();
-    this->PostProcessingShader.SetFloat("time", time);
-    this->PostProcessingShader.SetInteger("confuse", this->Confuse);
-    this->PostProcessingShader.SetInteger("chaos", this->Chaos);
-    this->PostProcessingShader.SetInteger("shake", this->Shake);
+    this->PostProcessingShader.SetInteger(this->confuseLocation, this->Confuse);
+    this->PostProcessingShader.SetInteger(this->chaosLocation, this->Chaos);
+    this->PostProcessingShader.SetInteger(this->shakeLocation, this->Shake);
     // render textured quad
     this->Texture.Bind();
-    glBindVertexArray(this->VAO);
+    RenderState::BindVertexArray(this->VAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
 }
 
 void PostProcessor::initRenderData()
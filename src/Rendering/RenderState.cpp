@@ -0,0 +1,138 @@
+#include "Rendering/RenderState.h"
+
+#include <iostream>
+
+#include <glad/glad.h>
+
+// Marks a binding whose GL value is not known
+const unsigned int UNKNOWN{ 0xFFFFFFFF };
+
+RenderStateStats RenderState::LastFrame;
+RenderStateStats RenderState::frame;
+unsigned int RenderState::program{ UNKNOWN };
+unsigned int RenderState::textures[RENDER_STATE_TEXTURE_UNITS]{ UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+unsigned int RenderState::vertexArray{ UNKNOWN };
+unsigned int RenderState::framebuffer{ UNKNOWN };
+unsigned int RenderState::blendSource{ UNKNOWN };
+unsigned int RenderState::blendDestination{ UNKNOWN };
+
+#ifdef _DEBUG
+// Reads a binding back from GL and reports a mismatch
+static void validate(const char* name, GLenum query, unsigned int expected)
+{
+    int bound = 0;
+    glGetIntegerv(query, &bound);
+    if (static_cast<unsigned int>(bound) != expected)
+    {
+        std::cout << "ERROR::RENDERSTATE: Failed to bind " << name << " " << expected << ", GL has " << bound << std::endl;
+    }
+}
+#endif
+
+void RenderState::UseProgram(unsigned int program)
+{
+    if (RenderState::program == program)
+    {
+        ++frame.Elided;
+        return;
+    }
+
+    glUseProgram(program);
+    RenderState::program = program;
+    ++frame.Issued;
+
+#ifdef _DEBUG
+    validate("program", GL_CURRENT_PROGRAM, program);
+#endif
+}
+
+void RenderState::BindTexture(unsigned int unit, unsigned int texture)
+{
+    if (unit < RENDER_STATE_TEXTURE_UNITS && textures[unit] == texture)
+    {
+        ++frame.Elided;
+        return;
+    }
+
+    glBindTextureUnit(unit, texture);
+    if (unit < RENDER_STATE_TEXTURE_UNITS)
+        textures[unit] = texture;
+    ++frame.Issued;
+
+#ifdef _DEBUG
+    // The binding query reads the active unit; nothing else changes it, so restore unit 0 afterwards
+    glActiveTexture(GL_TEXTURE0 + unit);
+    validate("texture", GL_TEXTURE_BINDING_2D, texture);
+    glActiveTexture(GL_TEXTURE0);
+#endif
+}
+
+void RenderState::BindVertexArray(unsigned int vertexArray)
+{
+    if (RenderState::vertexArray == vertexArray)
+    {
+        ++frame.Elided;
+        return;
+    }
+
+    glBindVertexArray(vertexArray);
+    RenderState::vertexArray = vertexArray;
+    ++frame.Issued;
+
+#ifdef _DEBUG
+    validate("vertex array", GL_VERTEX_ARRAY_BINDING, vertexArray);
+#endif
+}
+
+void RenderState::BindFramebuffer(unsigned int framebuffer)
+{
+    if (RenderState::framebuffer == framebuffer)
+    {
+        ++frame.Elided;
+        return;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    RenderState::framebuffer = framebuffer;
+    ++frame.Issued;
+
+#ifdef _DEBUG
+    validate("framebuffer", GL_DRAW_FRAMEBUFFER_BINDING, framebuffer);
+#endif
+}
+
+void RenderState::BlendFunc(unsigned int source, unsigned int destination)
+{
+    if (blendSource == source && blendDestination == destination)
+    {
+        ++frame.Elided;
+        return;
+    }
+
+    glBlendFunc(source, destination);
+    blendSource = source;
+    blendDestination = destination;
+    ++frame.Issued;
+
+#ifdef _DEBUG
+    validate("blend source", GL_BLEND_SRC_RGB, source);
+    validate("blend destination", GL_BLEND_DST_RGB, destination);
+#endif
+}
+
+void RenderState::Invalidate()
+{
+    program = UNKNOWN;
+    for (unsigned int& texture : textures)
+        texture = UNKNOWN;
+    vertexArray = UNKNOWN;
+    framebuffer = UNKNOWN;
+    blendSource = UNKNOWN;
+    blendDestination = UNKNOWN;
+}
+
+void RenderState::BeginFrame()
+{
+    LastFrame = frame;
+    frame = RenderStateStats{};
+}
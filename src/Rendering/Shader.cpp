@@ -1,10 +1,11 @@
 #include "Rendering/Shader.h"
+#include "Rendering/RenderState.h"
 #include <glad/glad.h>
 #include <iostream>
 
 Shader& Shader::Use()
 {
-    glUseProgram(this->ID);
+    RenderState::UseProgram(this->ID);
 
     return *this;
 }
@@ -39,8 +40,11 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
     glAttachShader(this->ID, sFragment);
     if (geometrySource != nullptr)
         glAttachShader(this->ID, gShader);
+    // Allow GetBinary to retrieve the linked program
+    glProgramParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
+    cacheUniforms();
 
     // Delete the shaders as they're linked into our program now and no longer necessery
     glDeleteShader(sVertex);
@@ -53,63 +57,174 @@ void Shader::SetFloat(const char* name, float value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform1f(glGetUniformLocation(this->ID, name), value);
+    glUniform1f(this->Location(name), value);
 }
 
 void Shader::SetInteger(const char* name, int value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform1i(glGetUniformLocation(this->ID, name), value);
+    glUniform1i(this->Location(name), value);
 }
 
 void Shader::SetVector2f(const char* name, float x, float y, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    glUniform2f(this->Location(name), x, y);
 }
 
 void Shader::SetVector2f(const char* name, const glm::vec2& value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    glUniform2f(this->Location(name), value.x, value.y);
 }
 
 void Shader::SetVector3f(const char* name, float x, float y, float z, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    glUniform3f(this->Location(name), x, y, z);
 }
 
 void Shader::SetVector3f(const char* name, const glm::vec3& value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    glUniform3f(this->Location(name), value.x, value.y, value.z);
 }
 
 void Shader::SetVector4f(const char* name, float x, float y, float z, float w, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    glUniform4f(this->Location(name), x, y, z, w);
 }
 
 void Shader::SetVector4f(const char* name, const glm::vec4& value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    glUniform4f(this->Location(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::SetMatrix4(const char* name, const glm::mat4& matrix, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, GL_FALSE, &matrix[0][0]);
+    glUniformMatrix4fv(this->Location(name), 1, GL_FALSE, &matrix[0][0]);
+}
+
+bool Shader::LoadBinary(unsigned int format, const void* binary, int length)
+{
+    this->ID = glCreateProgram();
+    glProgramBinary(this->ID, format, binary, length);
+
+    // The driver may reject binaries from another version; that is not an error, the caller compiles instead
+    int success = 0;
+    glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(this->ID);
+        this->ID = 0;
+        return false;
+    }
+
+    cacheUniforms();
+    return true;
+}
+
+bool Shader::GetBinary(unsigned int& format, std::vector<unsigned char>& binary) const
+{
+    int length = 0;
+    glGetProgramiv(this->ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    binary.resize(length);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(this->ID, length, &length, &binaryFormat, binary.data());
+    binary.resize(length);
+    format = binaryFormat;
+    return length > 0;
+}
+
+int Shader::Location(const char* name) const
+{
+    auto iter = this->uniforms.find(name);
+    return iter != this->uniforms.end() ? iter->second : -1;
+}
+
+void Shader::SetFloat(int location, float value, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniform1f(location, value);
+}
+
+void Shader::SetInteger(int location, int value, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniform1i(location, value);
+}
+
+void Shader::SetVector2f(int location, const glm::vec2& value, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniform2f(location, value.x, value.y);
+}
+
+void Shader::SetVector3f(int location, const glm::vec3& value, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniform3f(location, value.x, value.y, value.z);
+}
+
+void Shader::SetVector4f(int location, const glm::vec4& value, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetMatrix4(int location, const glm::mat4& matrix, bool useShader)
+{
+    if (useShader)
+        this->Use();
+    glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]);
+}
+
+void Shader::cacheUniforms()
+{
+    this->uniforms.clear();
+
+    int count = 0, maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(maxLength, '\0');
+    for (int i = 0; i < count; ++i)
+    {
+        int length = 0, size = 0;
+        GLenum type;
+        glGetActiveUniform(this->ID, i, maxLength, &length, &size, &type, name.data());
+
+        // Uniform block members have no location
+        std::string uniform = name.substr(0, length);
+        int location = glGetUniformLocation(this->ID, uniform.c_str());
+        if (location < 0)
+            continue;
+
+        this->uniforms[uniform] = location;
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+            this->uniforms[uniform.substr(0, uniform.size() - 3)] = location;
+    }
 }
 
 void Shader::checkCompileErrors(unsigned int object, std::string type)
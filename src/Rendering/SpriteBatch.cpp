@@ -0,0 +1,124 @@
+#include "Rendering/SpriteBatch.h"
+#include "Rendering/RenderState.h"
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+SpriteBatch::SpriteBatch(Shader& shader, unsigned int capacity)
+    : shader{ shader }
+    , quadVAO{ 0 }
+    , instanceVBO{ 0 }
+    , capacity{ capacity }
+    , texture{ nullptr }
+{
+    this->instances.reserve(capacity);
+    this->initRenderData();
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    glDeleteVertexArrays(1, &this->quadVAO);
+    glDeleteBuffers(1, &this->instanceVBO);
+}
+
+void SpriteBatch::Begin()
+{
+    this->instances.clear();
+    this->texture = nullptr;
+}
+
+void SpriteBatch::DrawSprite(Texture2D& texture, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color, const AtlasRegion& region)
+{
+    // A texture switch or a full buffer ends the current run
+    if (this->texture != nullptr && (this->texture->ID != texture.ID || this->instances.size() == this->capacity))
+    {
+        this->flush();
+    }
+
+    this->texture = &texture;
+    this->instances.push_back(SpriteInstance{ position, size, glm::vec4{ color, 1.0f }, region.Offset, region.Scale, rotate });
+}
+
+void SpriteBatch::End()
+{
+    this->flush();
+    this->texture = nullptr;
+}
+
+void SpriteBatch::flush()
+{
+    if (this->instances.empty())
+    {
+        return;
+    }
+
+    // Upload the instances and draw them all at once
+    glNamedBufferSubData(this->instanceVBO, 0, this->instances.size() * sizeof(SpriteInstance), this->instances.data());
+
+    this->shader.Use();
+    this->texture->Bind();
+
+    RenderState::BindVertexArray(this->quadVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(this->instances.size()));
+
+    this->instances.clear();
+}
+
+void SpriteBatch::initRenderData()
+{
+    // Configure VAO/VBO
+    unsigned int VBO;
+
+    // Define vertices
+    float vertices[]{
+        // position     // texture
+        0.0f, 1.0f,     0.0f, 1.0f,
+        1.0f, 0.0f,     1.0f, 0.0f,
+        0.0f, 0.0f,     0.0f, 0.0f,
+
+        0.0f, 1.0f,     0.0f, 1.0f,
+        1.0f, 1.0f,     1.0f, 1.0f,
+        1.0f, 0.0f,     1.0f, 0.0f
+    };
+
+    // Create vertex array object
+    glCreateVertexArrays(1, &this->quadVAO);
+
+    // Create the quad and instance buffers
+    glCreateBuffers(1, &VBO);
+    glNamedBufferStorage(VBO, sizeof(vertices), vertices, GL_DYNAMIC_STORAGE_BIT);
+
+    glCreateBuffers(1, &this->instanceVBO);
+    glNamedBufferStorage(this->instanceVBO, this->capacity * sizeof(SpriteInstance), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    // Binding 0: per-vertex quad, binding 1: per-instance sprite data
+    glVertexArrayVertexBuffer(this->quadVAO, 0, VBO, 0, 4 * sizeof(float));
+    glVertexArrayVertexBuffer(this->quadVAO, 1, this->instanceVBO, 0, sizeof(SpriteInstance));
+    glVertexArrayBindingDivisor(this->quadVAO, 1, 1);
+
+    // Attribute 0: position and texture coordinates
+    glEnableVertexArrayAttrib(this->quadVAO, 0);
+    glVertexArrayAttribFormat(this->quadVAO, 0, 4, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(this->quadVAO, 0, 0);
+
+    // Attribute 1: sprite position and size
+    glEnableVertexArrayAttrib(this->quadVAO, 1);
+    glVertexArrayAttribFormat(this->quadVAO, 1, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, Position));
+    glVertexArrayAttribBinding(this->quadVAO, 1, 1);
+
+    // Attribute 2: sprite color
+    glEnableVertexArrayAttrib(this->quadVAO, 2);
+    glVertexArrayAttribFormat(this->quadVAO, 2, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, Color));
+    glVertexArrayAttribBinding(this->quadVAO, 2, 1);
+
+    // Attribute 3: texture region offset and scale
+    glEnableVertexArrayAttrib(this->quadVAO, 3);
+    glVertexArrayAttribFormat(this->quadVAO, 3, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, TexOffset));
+    glVertexArrayAttribBinding(this->quadVAO, 3, 1);
+
+    // Attribute 4: rotation
+    glEnableVertexArrayAttrib(this->quadVAO, 4);
+    glVertexArrayAttribFormat(this->quadVAO, 4, 1, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, Rotation));
+    glVertexArrayAttribBinding(this->quadVAO, 4, 1);
+}
@@ -1,6 +1,6 @@
 #include "Rendering/Texture.h"
+#include "Rendering/RenderState.h"
 #include <glad/glad.h>
-#include <iostream>
 
 Texture2D::Texture2D()
     : ID{ 0 }
@@ -15,7 +15,7 @@ Texture2D::Texture2D()
 {
 }
 
-void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char* data)
+void Texture2D::Generate(unsigned int width, unsigned int height, const unsigned char* data)
 {
     this->Width = width;
     this->Height = height;
@@ -34,14 +34,7 @@ void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char*
     glTextureSubImage2D(this->ID, 0, 0, 0, width, height, this->ImageFormat, GL_UNSIGNED_BYTE, data);
 }
 
-void Texture2D::Bind() const
+void Texture2D::Bind(unsigned int unit) const
 {
-    glBindTextureUnit(0, this->ID);
-
-    // Check if the texture is bound
-    int boundTextureID = 0;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTextureID);
-    if (boundTextureID != static_cast<int>(this->ID)) {
-        std::cerr << "Failed to bind texture." << std::endl;
-    }
+    RenderState::BindTexture(unit, this->ID);
 }
@@ -0,0 +1,76 @@
+#include "Rendering/TextureAtlas.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <glad/glad.h>
+
+unsigned int TextureAtlas::Declare(const std::string& name)
+{
+    auto iter = this->regionNames.find(name);
+    if (iter != this->regionNames.end())
+        return iter->second;
+
+    unsigned int index = static_cast<unsigned int>(this->Regions.size());
+    this->Regions.push_back(AtlasRegion{});
+    this->regionNames[name] = index;
+    return index;
+}
+
+void TextureAtlas::Add(const std::string& name, const unsigned char* pixels, unsigned int width, unsigned int height)
+{
+    this->images.push_back(Image{ this->Declare(name), std::vector<unsigned char>(pixels, pixels + width * height * 4), width, height });
+}
+
+bool TextureAtlas::Build(unsigned int maxSize)
+{
+    std::vector<glm::uvec2> sizes;
+    for (const Image& image : this->images)
+        sizes.push_back(glm::uvec2{ image.Width, image.Height });
+
+    std::vector<AtlasRect> rects;
+    glm::uvec2 atlasSize{ 0 };
+    if (!PackAtlas(sizes, ATLAS_PADDING, maxSize, maxSize, rects, atlasSize))
+    {
+        std::cout << "ERROR::ATLAS: Images do not fit into a " << maxSize << "x" << maxSize << " atlas" << std::endl;
+        return false;
+    }
+
+    // Copy every image into place and extrude its edges into the padding
+    std::vector<const unsigned char*> sources;
+    for (const Image& image : this->images)
+        sources.push_back(image.Pixels.data());
+    std::vector<unsigned char> pixels = ComposeAtlas(sources, rects, ATLAS_PADDING, atlasSize);
+
+    for (size_t i = 0; i < this->images.size(); ++i)
+    {
+        const AtlasRect& rect = rects[i];
+
+        AtlasRegion region;
+        region.Offset = glm::vec2{ rect.X / static_cast<float>(atlasSize.x), rect.Y / static_cast<float>(atlasSize.y) };
+        region.Scale = glm::vec2{ rect.Width / static_cast<float>(atlasSize.x), rect.Height / static_cast<float>(atlasSize.y) };
+        this->Regions[this->images[i].Region] = region;
+    }
+
+    // Upload
+    this->Texture.InternalFormat = GL_RGBA8;
+    this->Texture.ImageFormat = GL_RGBA;
+    this->Texture.WrapS = GL_CLAMP_TO_EDGE;
+    this->Texture.WrapT = GL_CLAMP_TO_EDGE;
+    this->Texture.Generate(atlasSize.x, atlasSize.y, pixels.data());
+
+    this->images.clear();
+    return true;
+}
+
+unsigned int TextureAtlas::FindRegion(const std::string& name) const
+{
+    auto iter = this->regionNames.find(name);
+    if (iter == this->regionNames.end())
+    {
+        std::cout << "ERROR::ATLAS: Unknown region " << name << std::endl;
+        std::abort();
+    }
+
+    return iter->second;
+}
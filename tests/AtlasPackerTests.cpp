@@ -0,0 +1,226 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Rendering/AtlasPacker.h>
+
+static bool isPowerOfTwo(unsigned int value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+static bool byPosition(const AtlasRect& a, const AtlasRect& b)
+{
+    return a.Y != b.Y ? a.Y < b.Y : a.X < b.X;
+}
+
+// Whether a width x height atlas could hold the padded images at all: it has to fit the widest and the tallest one and
+// the sum of their areas
+static bool couldFit(const std::vector<glm::uvec2>& sizes, unsigned int padding, unsigned int width, unsigned int height)
+{
+    unsigned long long area = 0;
+    for (const glm::uvec2& size : sizes)
+    {
+        if (size.x + 2 * padding > width || size.y + 2 * padding > height)
+            return false;
+        area += static_cast<unsigned long long>(size.x + 2 * padding) * (size.y + 2 * padding);
+    }
+    return area <= static_cast<unsigned long long>(width) * height;
+}
+
+// Padded rects stay inside the atlas and do not overlap each other
+static void checkNoOverlap(const std::vector<AtlasRect>& rects, unsigned int padding, glm::uvec2 atlasSize)
+{
+    for (size_t i = 0; i < rects.size(); ++i)
+    {
+        const AtlasRect& a = rects[i];
+        CHECK(a.X >= padding && a.Y >= padding);
+        CHECK(a.X + a.Width + padding <= atlasSize.x && a.Y + a.Height + padding <= atlasSize.y);
+
+        for (size_t j = i + 1; j < rects.size(); ++j)
+        {
+            const AtlasRect& b = rects[j];
+            bool apartX = a.X + a.Width + padding <= b.X - padding || b.X + b.Width + padding <= a.X - padding;
+            bool apartY = a.Y + a.Height + padding <= b.Y - padding || b.Y + b.Height + padding <= a.Y - padding;
+            CHECK(apartX || apartY);
+        }
+    }
+}
+
+// Permuting the input moves images between slots of the same size but does not change the layout
+static void testPermutedInput()
+{
+    std::vector<glm::uvec2> sizes{ { 16, 16 }, { 16, 16 }, { 16, 16 }, { 30, 8 }, { 8, 30 }, { 12, 12 }, { 12, 12 }, { 5, 3 } };
+    std::vector<AtlasRect> rects;
+    glm::uvec2 atlasSize{ 0 };
+    CHECK(PackAtlas(sizes, ATLAS_PADDING, 4096, 4096, rects, atlasSize));
+
+    std::vector<AtlasRect> layout = rects;
+    std::sort(layout.begin(), layout.end(), byPosition);
+
+    std::mt19937 random{ 7 };
+    for (int run = 0; run < 20; ++run)
+    {
+        std::vector<unsigned int> order{ 0, 1, 2, 3, 4, 5, 6, 7 };
+        std::shuffle(order.begin(), order.end(), random);
+
+        std::vector<glm::uvec2> permuted;
+        for (unsigned int index : order)
+            permuted.push_back(sizes[index]);
+
+        std::vector<AtlasRect> permutedRects;
+        glm::uvec2 permutedSize{ 0 };
+        CHECK(PackAtlas(permuted, ATLAS_PADDING, 4096, 4096, permutedRects, permutedSize));
+        CHECK(permutedSize == atlasSize);
+
+        // Every image still lands in a slot of its own size, and the slots are the same
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            CHECK(permutedRects[i].Width == sizes[order[i]].x && permutedRects[i].Height == sizes[order[i]].y);
+        }
+        std::sort(permutedRects.begin(), permutedRects.end(), byPosition);
+        for (size_t i = 0; i < layout.size(); ++i)
+        {
+            CHECK(permutedRects[i].X == layout[i].X && permutedRects[i].Y == layout[i].Y);
+        }
+    }
+
+    // Images of equal size are placed in input order, so equal input gives equal rects per index
+    std::vector<glm::uvec2> equal(6, glm::uvec2{ 10, 10 });
+    std::vector<AtlasRect> first, second;
+    glm::uvec2 firstSize{ 0 }, secondSize{ 0 };
+    CHECK(PackAtlas(equal, ATLAS_PADDING, 4096, 4096, first, firstSize));
+    CHECK(PackAtlas(equal, ATLAS_PADDING, 4096, 4096, second, secondSize));
+    CHECK(firstSize == secondSize);
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        CHECK(first[i].X == second[i].X && first[i].Y == second[i].Y);
+        if (i > 0)
+            CHECK(byPosition(first[i - 1], first[i]));
+    }
+}
+
+static void testNoOverlap()
+{
+    std::mt19937 random{ 11 };
+    std::uniform_int_distribution<unsigned int> side{ 1, 40 };
+    for (int run = 0; run < 50; ++run)
+    {
+        std::vector<glm::uvec2> sizes(1 + run);
+        for (glm::uvec2& size : sizes)
+            size = glm::uvec2{ side(random), side(random) };
+
+        std::vector<AtlasRect> rects;
+        glm::uvec2 atlasSize{ 0 };
+        CHECK(PackAtlas(sizes, ATLAS_PADDING, 4096, 4096, rects, atlasSize));
+        CHECK(rects.size() == sizes.size());
+        checkNoOverlap(rects, ATLAS_PADDING, atlasSize);
+    }
+}
+
+static void testSmallestPowerOfTwo()
+{
+    struct Case
+    {
+        std::vector<glm::uvec2> Sizes;
+        glm::uvec2 Expected;
+    };
+    // Padded areas that leave no smaller power-of-two atlas possible; equal areas go to the narrower
+    std::vector<Case> cases{
+        { { { 28, 28 } }, { 32, 32 } },
+        { { { 29, 28 } }, { 64, 32 } },
+        { std::vector<glm::uvec2>(16, glm::uvec2{ 12, 12 }), { 16, 256 } },
+        { { { 60, 28 }, { 28, 28 }, { 28, 28 } }, { 64, 64 } },
+        { { { 124, 60 }, { 60, 60 }, { 60, 60 }, { 28, 28 }, { 28, 28 }, { 28, 28 }, { 28, 28 } }, { 128, 256 } },
+    };
+
+    for (const Case& test : cases)
+    {
+        std::vector<AtlasRect> rects;
+        glm::uvec2 atlasSize{ 0 };
+        CHECK(PackAtlas(test.Sizes, ATLAS_PADDING, 4096, 4096, rects, atlasSize));
+        CHECK(atlasSize == test.Expected);
+        checkNoOverlap(rects, ATLAS_PADDING, atlasSize);
+
+        // No power-of-two atlas of smaller area could hold the padded images
+        for (unsigned int width = 1; width <= 4096; width *= 2)
+        {
+            for (unsigned int height = 1; height <= 4096; height *= 2)
+            {
+                if (static_cast<unsigned long long>(width) * height < static_cast<unsigned long long>(atlasSize.x) * atlasSize.y)
+                    CHECK(!couldFit(test.Sizes, ATLAS_PADDING, width, height));
+            }
+        }
+    }
+
+    // Any result is a power of two in both directions
+    std::vector<glm::uvec2> sizes{ { 33, 7 }, { 3, 50 }, { 17, 17 }, { 1, 1 } };
+    std::vector<AtlasRect> rects;
+    glm::uvec2 atlasSize{ 0 };
+    CHECK(PackAtlas(sizes, ATLAS_PADDING, 4096, 4096, rects, atlasSize));
+    CHECK(isPowerOfTwo(atlasSize.x) && isPowerOfTwo(atlasSize.y));
+
+    // Images that do not fit the limits are refused
+    CHECK(!PackAtlas({ { 61, 10 } }, ATLAS_PADDING, 64, 64, rects, atlasSize));
+    CHECK(!PackAtlas(std::vector<glm::uvec2>(5, glm::uvec2{ 28, 28 }), ATLAS_PADDING, 64, 64, rects, atlasSize));
+}
+
+// Every pixel of the padded rect holds the image pixel nearest to it, and nothing else is written
+static void testEdgeExtrusion()
+{
+    std::vector<glm::uvec2> sizes{ { 3, 2 }, { 1, 1 }, { 4, 5 }, { 2, 3 }, { 7, 1 } };
+
+    // A different byte for every pixel and channel of an image
+    std::vector<std::vector<unsigned char>> images;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        std::vector<unsigned char> image(sizes[i].x * sizes[i].y * 4);
+        for (size_t byte = 0; byte < image.size(); ++byte)
+            image[byte] = static_cast<unsigned char>(1 + i * 50 + byte);
+        images.push_back(image);
+    }
+
+    std::vector<AtlasRect> rects;
+    glm::uvec2 atlasSize{ 0 };
+    CHECK(PackAtlas(sizes, ATLAS_PADDING, 4096, 4096, rects, atlasSize));
+
+    std::vector<const unsigned char*> sources;
+    for (const std::vector<unsigned char>& image : images)
+        sources.push_back(image.data());
+    std::vector<unsigned char> pixels = ComposeAtlas(sources, rects, ATLAS_PADDING, atlasSize);
+    CHECK(pixels.size() == atlasSize.x * atlasSize.y * 4);
+
+    std::vector<bool> covered(atlasSize.x * atlasSize.y, false);
+    for (size_t i = 0; i < rects.size(); ++i)
+    {
+        const AtlasRect& rect = rects[i];
+        for (unsigned int y = rect.Y - ATLAS_PADDING; y < rect.Y + rect.Height + ATLAS_PADDING; ++y)
+        {
+            for (unsigned int x = rect.X - ATLAS_PADDING; x < rect.X + rect.Width + ATLAS_PADDING; ++x)
+            {
+                unsigned int sourceX = std::min(std::max(x, rect.X), rect.X + rect.Width - 1) - rect.X;
+                unsigned int sourceY = std::min(std::max(y, rect.Y), rect.Y + rect.Height - 1) - rect.Y;
+                const unsigned char* expected = &images[i][(sourceY * rect.Width + sourceX) * 4];
+                CHECK(std::memcmp(&pixels[(y * atlasSize.x + x) * 4], expected, 4) == 0);
+                covered[y * atlasSize.x + x] = true;
+            }
+        }
+    }
+
+    for (size_t pixel = 0; pixel < covered.size(); ++pixel)
+    {
+        if (!covered[pixel])
+            CHECK(pixels[pixel * 4] == 0 && pixels[pixel * 4 + 1] == 0 && pixels[pixel * 4 + 2] == 0 && pixels[pixel * 4 + 3] == 0);
+    }
+}
+
+void TestAtlasPacker()
+{
+    testPermutedInput();
+    testNoOverlap();
+    testSmallestPowerOfTwo();
+    testEdgeExtrusion();
+}
@@ -0,0 +1,143 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Core/JobSystem.h>
+
+// Worker counts to run every test with besides none at all: fewer workers than outside threads, and more
+const unsigned int WORKER_COUNTS[]{ 2, 5 };
+
+// Ranges cover [0, count) exactly once, start at multiples of the grain and hold at most a grain each, with or without
+// workers. The first range runs on the calling thread; an empty count has no ranges.
+static void testRanges()
+{
+    const unsigned int counts[]{ 0, 1, 7, 64, 100, 1000, 1001 };
+    const unsigned int grains[]{ 1, 16, 64, 100, 5000 };
+
+    for (unsigned int count : counts)
+    {
+        for (unsigned int grain : grains)
+        {
+            std::vector<std::atomic<unsigned int>> hits(count);
+            std::atomic<bool> aligned{ true };
+            std::atomic<bool> firstInline{ false };
+            std::thread::id caller = std::this_thread::get_id();
+
+            JobSystem::ParallelFor(count, grain, [&](unsigned int first, unsigned int last) {
+                if (first % grain != 0 || last != std::min(first + grain, count))
+                    aligned = false;
+                if (first == 0 && std::this_thread::get_id() == caller)
+                    firstInline = true;
+                for (unsigned int i = first; i < last; ++i)
+                    ++hits[i];
+            });
+
+            CHECK(aligned);
+            CHECK(firstInline || count == 0);
+            CHECK(std::all_of(hits.begin(), hits.end(), [](const std::atomic<unsigned int>& hit) { return hit == 1; }));
+        }
+    }
+}
+
+// More outside threads than EXTERNAL_QUEUES, so some share a deque, each running jobs that run nested ParallelFors
+static void testOutsideThreads()
+{
+    const unsigned int threadCount = EXTERNAL_QUEUES + 2;
+    const unsigned int rounds = 50, jobs = 6, count = 2000;
+
+    std::atomic<unsigned long long> total{ 0 };
+    auto body = [&]() {
+        for (unsigned int round = 0; round < rounds; ++round)
+        {
+            JobCounter counter;
+            for (unsigned int job = 0; job < jobs; ++job)
+            {
+                JobSystem::Run([&]() {
+                    JobSystem::ParallelFor(count, 100, [&](unsigned int first, unsigned int last) { total += last - first; });
+                }, counter);
+            }
+            JobSystem::Wait(counter);
+            CHECK(counter.Done());
+        }
+    };
+
+    std::vector<std::thread> outside;
+    for (unsigned int i = 1; i < threadCount; ++i)
+        outside.emplace_back(body);
+    body();
+    for (std::thread& thread : outside)
+        thread.join();
+
+    CHECK(total == static_cast<unsigned long long>(threadCount) * rounds * jobs * count);
+}
+
+// Wait outlasts jobs that run far longer than its spinning, wakes for jobs queued while it sleeps, and respects
+// dependencies
+static void testWaitWakes()
+{
+    std::atomic<unsigned int> done{ 0 };
+
+    // A job that sleeps long enough for the waiting thread to go to sleep as well
+    JobCounter slow;
+    JobSystem::Run([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ++done;
+    }, slow);
+    JobSystem::Wait(slow);
+    CHECK(slow.Done());
+    CHECK(done == 1);
+
+    // Jobs queued by a running job while the caller is already waiting
+    JobCounter outer, inner;
+    JobSystem::Run([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        for (int i = 0; i < 8; ++i)
+        {
+            JobSystem::Run([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                ++done;
+            }, inner);
+        }
+        JobSystem::Wait(inner);
+    }, outer);
+    JobSystem::Wait(outer);
+    CHECK(outer.Done() && inner.Done());
+    CHECK(done == 9);
+
+    // A dependent job starts only once its dependency is done, and waking for it works the same way
+    JobCounter first, second;
+    std::atomic<bool> ordered{ false };
+    JobSystem::Run([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++done;
+    }, first);
+    JobSystem::Run([&]() { ordered = first.Done(); }, second, &first);
+    JobSystem::Wait(second);
+    CHECK(ordered);
+    CHECK(done == 10);
+}
+
+void TestJobSystem()
+{
+    // Before Start every job runs on the waiting thread
+    testRanges();
+    testOutsideThreads();
+    testWaitWakes();
+
+    for (unsigned int workers : WORKER_COUNTS)
+    {
+        JobSystem::Start(workers);
+        CHECK(JobSystem::WorkerCount() == workers);
+
+        testRanges();
+        testOutsideThreads();
+        testWaitWakes();
+
+        JobSystem::Stop();
+    }
+}
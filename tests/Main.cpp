@@ -0,0 +1,19 @@
+#include "Test.h"
+
+unsigned int TestFailures{ 0 };
+
+// Runs every test group and returns the number of failed checks
+int main()
+{
+    TestAtlasPacker();
+    TestJobSystem();
+
+    if (TestFailures != 0)
+    {
+        std::cout << TestFailures << " checks failed" << std::endl;
+        return static_cast<int>(TestFailures);
+    }
+
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <iostream>
+
+// Number of failed checks; the test runner exits with it
+extern unsigned int TestFailures;
+
+// Reports a failed condition and keeps going, so one run shows every failure
+#define CHECK(condition)                                                                                        \
+    do                                                                                                          \
+    {                                                                                                           \
+        if (!(condition))                                                                                       \
+        {                                                                                                       \
+            ++TestFailures;                                                                                     \
+            std::cout << "FAILED::" << __FILE__ << "(" << __LINE__ << "): " << #condition << std::endl;         \
+        }                                                                                                       \
+    } while (0)
+
+// Test groups, one per file
+void TestAtlasPacker();
+void TestJobSystem();